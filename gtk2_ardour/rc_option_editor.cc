@@ -4794,6 +4794,16 @@ These settings will only take effect after %1 is restarted.\n\
 		procs->set_note (string_compose (_("This setting will only take effect when %1 is restarted."), PROGRAM_NAME));
 
 		add_option (_("Performance"), procs);
+
+		bo = new BoolOption (
+				"graph-work-stealing",
+				_("Use per-thread work queues (work stealing) for parallel processing"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_graph_work_stealing),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_graph_work_stealing)
+				);
+		Gtkmm2ext::UI::instance()->set_tip (bo->tip_widget(),
+				_("When enabled, each processing thread keeps the routes it triggers in its own queue, and idle threads take work from busy ones. This reduces contention on large sessions with many processing threads. When disabled, all threads share a single queue. The setting takes effect immediately."));
+		add_option (_("Performance"), bo);
 	}
 
 #if !(defined PLATFORM_WINDOWS || defined __APPLE__)
@@ -4906,6 +4916,25 @@ These settings will only take effect after %1 is restarted.\n\
 
 	add_option (_("Performance"), new BufferingOptions (_rc_config));
 
+	if (hwcpus > 1) {
+		ComboOption<uint32_t>* bt = new ComboOption<uint32_t> (
+				"butler-threads",
+				_("Disk I/O threads"),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::get_butler_threads),
+				sigc::mem_fun (*_rc_config, &RCConfiguration::set_butler_threads)
+				);
+
+		bt->add (0, _("Automatic"));
+
+		for (uint32_t i = 1; i <= std::min<uint32_t> (hwcpus, 16); ++i) {
+			bt->add (i, string_compose (P_("%1 thread", "%1 threads", i), i));
+		}
+
+		bt->set_note (_("Additional threads read and write tracks concurrently, which helps with large track counts on fast storage.\nThis setting will only take effect when the session is reloaded."));
+
+		add_option (_("Performance"), bt);
+	}
+
 	/* Image cache size */
 	add_option (_("Performance"), new OptionEditorHeading (_("Memory Usage")));
 
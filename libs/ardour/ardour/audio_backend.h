@@ -433,6 +433,15 @@ public:
 	 * otherwise.
 	 */
 	virtual bool can_change_buffer_size_when_running () const = 0;
+	/* Return true if the buffer size can be changed while running and
+	 * only affects this process, so that it can be raised temporarily
+	 * for a freewheel export. Return false otherwise. (example: the JACK
+	 * buffer size is shared by all clients)
+	 */
+	virtual bool can_change_buffer_size_for_export () const
+	{
+		return false;
+	}
 
 	/** return true if the backend is configured using a single
 	 * full-duplex device and measuring systemic latency can
@@ -59,6 +59,31 @@ private:
 	bool region_changed (const PBD::PropertyChange&, std::shared_ptr<Region>);
 	void source_offset_changed (std::shared_ptr<AudioRegion>);
         void load_legacy_crossfades (const XMLNode&, int version);
+
+	/** A segment of region that needs to be read */
+	struct Segment {
+		Segment (std::shared_ptr<AudioRegion> r, Temporal::Range a) : region (r), range (a) {}
+
+		std::shared_ptr<AudioRegion> region; ///< the region
+		Temporal::Range range;       ///< range of the region to read, in session samples
+	};
+
+	/** The segments to read for a range of the playlist, in the order
+	 * they have to be read (later segments overwrite earlier ones).
+	 */
+	struct ReadPlan {
+		uint64_t             generation;
+		timepos_t            start;
+		timepos_t            end;
+		std::vector<Segment> segments;
+	};
+
+	std::shared_ptr<ReadPlan const> read_plan (timepos_t const & start, timepos_t const & end);
+
+	/* the most recently used plan, shared by all channels and re-used by
+	 * subsequent reads until the playlist is modified.
+	 */
+	std::shared_ptr<ReadPlan const> _read_plan;
 };
 
 } /* namespace ARDOUR */
@@ -23,7 +23,9 @@
 #ifndef __ardour_audio_source_h__
 #define __ardour_audio_source_h__
 
+#include <atomic>
 #include <memory>
+#include <vector>
 
 #include <boost/shared_array.hpp>
 
@@ -79,6 +81,21 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int rename_peakfile (std::string newpath);
 	void touch_peakfile ();
 
+	/* In addition to the peakfile (one peak per 256 samples), reduced
+	 * resolution levels are kept in companion files, each level
+	 * combining 4 peaks of the level below. read_peaks() picks the
+	 * coarsest level that still satisfies the requested zoom.
+	 */
+	static const uint32_t n_peak_levels = 5;
+	static std::string peak_level_path (std::string const & peakpath, uint32_t level);
+
+	/** Check or compute the reduced peak levels of an existing peakfile.
+	 * This may read the whole peakfile, and is called by the peak
+	 * building threads (see SourceFactory::build_peak_levels), until then
+	 * read_peaks() uses the full resolution peakfile.
+	 */
+	int build_peak_levels ();
+
 	static void set_build_missing_peakfiles (bool yn) {
 		_build_missing_peakfiles = yn;
 	}
@@ -121,6 +138,7 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 	int compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, samplecnt_t cnt,
 	bool force, bool intermediate_peaks_ready_signal);
 	void truncate_peakfile();
+	void unlink_peak_levels () const;
 
 	mutable off_t _peak_byte_max; // modified in compute_and_write_peak()
 
@@ -137,6 +155,27 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 				     samplecnt_t samples_per_peak);
 
   private:
+	struct IndexedPeak {
+		IndexedPeak (samplepos_t i, PeakData const& p) : index (i), peak (p) {}
+		samplepos_t index;
+		PeakData    peak;
+	};
+
+	struct PeakLevel {
+		PeakLevel () : fd (-1), index (-1), byte_max (0) {}
+
+		int         fd;
+		samplepos_t index;    ///< peak being accumulated at this level, -1 if none
+		PeakData    peak;
+		off_t       byte_max;
+	};
+
+	int      prepare_for_peak_level_writes ();
+	void     done_with_peak_level_writes (bool done);
+	int      write_peak_levels (std::vector<IndexedPeak>&, bool flush);
+	void     truncate_peak_levels ();
+	uint32_t usable_peak_level (double samples_per_visual_peak) const;
+
 	bool _peaks_built;
 	/** This mutex is used to protect both the _peaks_built
 	 *  variable and also the emission (and handling) of the
@@ -148,6 +187,12 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
         Glib::Threads::Mutex _initialize_peaks_lock;
 
 	int        _peakfile_fd;
+	PeakLevel  _peak_level[n_peak_levels]; ///< levels 1 .. n_peak_levels
+	std::atomic<int> _peak_levels_valid;  ///< number of usable levels, -1: not yet checked, -2: queued
+	/** protects _peak_level. Recursive, since build_peak_levels() uses
+	 *  the same helpers as peak writes. Must not be held when taking _lock.
+	 */
+	mutable Glib::Threads::RecMutex _peak_levels_lock;
 	samplecnt_t peak_leftover_cnt;
 	samplecnt_t peak_leftover_size;
 	Sample*    peak_leftovers;
@@ -155,6 +200,7 @@ class LIBARDOUR_API AudioSource : virtual public Source, public ARDOUR::AudioRea
 
 	mutable bool _first_run;
 	mutable double _last_scale;
+	mutable samplecnt_t _last_fpp;
 	mutable off_t _last_map_off;
 	mutable size_t  _last_raw_map_length;
 	mutable boost::scoped_array<PeakData> peak_cache;
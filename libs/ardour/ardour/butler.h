@@ -24,6 +24,7 @@
 #define __ardour_butler_h__
 
 #include <atomic>
+#include <vector>
 
 #include <pthread.h>
 
@@ -31,6 +32,7 @@
 
 #include "pbd/crossthread.h"
 #include "pbd/pool.h"
+#include "pbd/pthread_utils.h"
 #include "pbd/ringbuffer.h"
 #include "pbd/mpmc_queue.h"
 
@@ -40,6 +42,8 @@
 
 namespace ARDOUR
 {
+class Track;
+
 /**
  *  One of the Butler's functions is to clean up (ie delete) unused CrossThreadPools.
  *  When a thread with a CrossThreadPool terminates, its CTP is added to pool_trash.
@@ -82,6 +86,13 @@ public:
 		return _midi_buffer_size;
 	}
 
+	/** Query statistics of the time (in usec) from summon() until the
+	 * butler has completed the disk work that was requested.
+	 * @return false if no data is available
+	 */
+	bool refill_latency (int64_t& min, int64_t& max, double& avg, uint64_t& cnt) const;
+	void reset_refill_latency ();
+
 	mutable std::atomic<int> should_do_transport_work;
 
 private:
@@ -94,14 +105,41 @@ private:
 	};
 
 
+	/** A unit of disk work handed to the worker pool */
+	struct DiskJob {
+		DiskJob (std::shared_ptr<Track> t, bool f, float l)
+			: track (t), flush (f), load (l) {}
+
+		std::shared_ptr<Track> track;
+		bool                   flush;
+		float                  load;
+	};
+
+	struct DiskJobSorter {
+		/* capture flushes before playback refills, most starved first */
+		bool operator() (DiskJob const& a, DiskJob const& b) const {
+			if (a.flush != b.flush) {
+				return a.flush;
+			}
+			return a.load < b.load;
+		}
+	};
+
 	static void* _thread_work (void* arg);
 
 	void* thread_work ();
+	void  worker_thread_work ();
 
 	void empty_pool_trash ();
 	void process_delegated_work ();
 	void config_changed (std::string);
+	bool refill_tracks_normal (RouteList const&);
 	bool flush_tracks_to_disk_normal (std::shared_ptr<RouteList const>, uint32_t& errors);
+	bool flush_and_refill_tracks_parallel (std::shared_ptr<RouteList const>, RouteList const&, uint32_t& errors);
+	void process_disk_jobs (Glib::Threads::Mutex::Lock&);
+	int  run_disk_job (DiskJob const&);
+	void start_workers ();
+	void stop_workers ();
 	void queue_request (Request::Type r);
 
 	pthread_t thread;
@@ -118,6 +156,28 @@ private:
 	PBD::RingBuffer<PBD::CrossThreadPool*> pool_trash;
 	CrossThreadChannel                    _xthread;
 	PBD::MPMCQueue<sigc::slot<void> >     _delegated_work;
+
+	/* optional pool of additional disk i/o threads, see "butler-threads".
+	 * The butler thread itself hands out work and takes part in it.
+	 */
+	std::vector<PBD::Thread*> _workers;
+	Glib::Threads::Mutex      _job_lock;
+	Glib::Threads::Cond       _job_available;
+	Glib::Threads::Cond       _jobs_done;
+	std::vector<DiskJob>      _jobs;
+	size_t                    _next_job;
+	uint32_t                  _jobs_active;
+	uint32_t                  _job_errors;
+	bool                      _jobs_outstanding;
+	bool                      _workers_run;
+
+	/* refill latency statistics */
+	std::atomic<int64_t>         _summon_time;
+	mutable Glib::Threads::Mutex _latency_lock;
+	int64_t                      _latency_min;
+	int64_t                      _latency_max;
+	double                       _latency_sum;
+	uint64_t                     _latency_cnt;
 };
 
 } // namespace ARDOUR
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _ardour_clip_sample_store_h_
+#define _ardour_clip_sample_store_h_
+
+#include <map>
+#include <memory>
+
+#include <glibmm/threads.h>
+
+#include "pbd/id.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioSource;
+
+/** Decoded audio data of trigger-slot clips, shared between triggers.
+ *
+ * Buffers are keyed by source, start and length. A clip that is placed
+ * in several slots is read from disk and kept in memory only once.
+ * Buffers are read-only once loaded, and released when the last
+ * trigger using them drops its reference.
+ */
+class LIBARDOUR_API ClipSampleStore
+{
+public:
+	class LIBARDOUR_API Buffer
+	{
+	public:
+		~Buffer ();
+
+		Sample*     data () const { return _data; }
+		samplecnt_t length () const { return _length; }
+
+	private:
+		friend class ClipSampleStore;
+		Buffer (samplecnt_t);
+
+		Sample*     _data;
+		samplecnt_t _length;
+	};
+
+	typedef std::shared_ptr<Buffer> BufferPtr;
+
+	static ClipSampleStore& instance ();
+
+	/** Look up, or load, @param length samples of @param src
+	 * starting at @param start.
+	 * @return buffer, or an empty pointer if reading failed
+	 */
+	BufferPtr get (std::shared_ptr<AudioSource> src, samplepos_t start, samplecnt_t length);
+
+	/** @return number of bytes used by all buffers */
+	size_t memory_footprint () const;
+	/** @return number of distinct buffers */
+	size_t n_buffers () const;
+
+private:
+	ClipSampleStore () {}
+
+	size_t memory_footprint_locked () const;
+
+	struct Key {
+		Key (PBD::ID const& i, samplepos_t s, samplecnt_t l) : id (i), start (s), length (l) {}
+
+		PBD::ID     id;
+		samplepos_t start;
+		samplecnt_t length;
+
+		bool operator< (Key const& other) const {
+			if (id != other.id) {
+				return id < other.id;
+			}
+			if (start != other.start) {
+				return start < other.start;
+			}
+			return length < other.length;
+		}
+	};
+
+	/* An entry is added before the data is read, without holding the
+	 * lock. Concurrent requests for the same clip wait for it.
+	 */
+	struct Entry {
+		Entry () : pending (true) {}
+
+		std::weak_ptr<Buffer> buffer;
+		bool                  pending;
+	};
+
+	typedef std::map<Key, Entry> Buffers;
+
+	mutable Glib::Threads::Mutex _lock;
+	Glib::Threads::Cond          _loaded;
+	Buffers                      _buffers;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_clip_sample_store_h_ */
@@ -0,0 +1,105 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+#ifndef _ardour_clip_stream_h_
+#define _ardour_clip_stream_h_
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "pbd/ringbuffer.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class AudioRegion;
+
+/** Disk-streaming part of a long trigger-slot clip.
+ *
+ * The head of the clip is kept in memory by the trigger; this
+ * provides the rest, from a ringbuffer that is refilled by the
+ * TriggerBoxThread.
+ *
+ * ::read() and ::seek() are called by the process thread.
+ * ::refill() is called by the worker thread.
+ */
+class LIBARDOUR_API ClipStream
+{
+public:
+	/** @param head first sample that is streamed, relative to the region start
+	 * @param bufsize size of the ringbuffer in samples per channel
+	 */
+	ClipStream (std::shared_ptr<AudioRegion>, samplecnt_t head, samplecnt_t bufsize);
+	~ClipStream ();
+
+	uint32_t    n_channels () const { return _n_channels; }
+	samplecnt_t head () const { return _head; }
+
+	/** Read @param cnt samples of all channels starting at @param pos
+	 * to dst[chn] + @param offset. Samples that are not (yet) buffered
+	 * are silenced, and the stream is repositioned if needed.
+	 * @return number of samples read from the buffer
+	 */
+	samplecnt_t read (Sample* const* dst, samplecnt_t offset, samplepos_t pos, samplecnt_t cnt);
+
+	/** Position the stream, so that the next read starts at @param pos */
+	void seek (samplepos_t pos);
+
+	/** @return true once, when the worker thread should call ::refill() */
+	bool want_refill () { return _want_refill.exchange (false); }
+
+	/** Fill the buffer, reset it first if a seek is pending */
+	void refill ();
+
+	uint32_t underruns () const { return _underruns.load (); }
+
+private:
+	void silence (Sample* const* dst, samplecnt_t offset, samplecnt_t cnt) const;
+	void request_refill ();
+	bool ready () const { return _served_seek.load () == _seek_id.load (); }
+	samplecnt_t read_space () const;
+	samplecnt_t write_space () const;
+
+	std::shared_ptr<AudioRegion>           _region;
+	uint32_t                               _n_channels;
+	samplecnt_t                            _length;
+	samplecnt_t                            _head;
+	samplecnt_t                            _lookahead;
+	std::vector<PBD::RingBuffer<Sample>*>  _rb;
+
+	/* process thread */
+	samplepos_t _read_pos;
+	bool        _dirty;
+
+	/* worker thread */
+	samplepos_t _fill_pos;
+
+	std::atomic<samplepos_t> _seek_pos;
+	std::atomic<uint32_t>    _seek_id;
+	std::atomic<uint32_t>    _served_seek;
+	std::atomic<bool>        _want_refill;
+	std::atomic<bool>        _pending;
+	std::atomic<bool>        _eof;
+	std::atomic<uint32_t>    _underruns;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_clip_stream_h_ */
@@ -155,12 +155,6 @@ protected:
 		 */
 		PBD::PlaybackBuffer<Sample>* rbuf;
 
-		/** A ringbuffer for data to be recorded back, written to in the
-		 * process thread, read from in the butler thread.
-		 */
-		PBD::RingBufferNPT<Sample>* wbuf;
-		PBD::RingBufferNPT<Sample>::rw_vector rw_vector;
-
 		/* used only by capture */
 		std::shared_ptr<AudioFileSource> write_source;
 		PBD::RingBufferNPT<CaptureTransition>* capture_transition_buf;
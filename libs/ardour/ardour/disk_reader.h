@@ -89,6 +89,10 @@ public:
 	/* Working buffers for do_refill (butler thread) */
 	static void allocate_working_buffers ();
 	static void free_working_buffers ();
+	/* Private working buffers for additional butler worker threads,
+	 * released when the calling thread exits.
+	 */
+	static void allocate_thread_working_buffers ();
 
 	void adjust_buffering ();
 
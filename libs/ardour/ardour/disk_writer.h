@@ -25,6 +25,8 @@
 #include <vector>
 #include <boost/optional.hpp>
 
+#include "pbd/multichannel_ringbuffer.h"
+
 #include "ardour/disk_io.h"
 #include "ardour/midi_buffer.h"
 
@@ -163,6 +165,7 @@ private:
 	void check_record_status (samplepos_t transport_sample, double speed, bool can_record);
 	void finish_capture (std::shared_ptr<ChannelList const> c);
 	void reset_capture ();
+	void alloc_capture_buffer (uint32_t n_chan);
 
 	void loop (samplepos_t);
 
@@ -193,6 +196,13 @@ private:
 	std::atomic<int> _samples_pending_write;
 	std::atomic<int> _num_captured_loops;
 
+	/** Audio data to be written to disk, one channel per ChannelInfo.
+	 * Written to in the process thread, read from in the butler thread.
+	 * All channels share a single read and write index. Only replaced
+	 * while holding the process lock.
+	 */
+	std::shared_ptr<PBD::MultiChannelRingBuffer<Sample> > _capture_buf;
+
 	std::shared_ptr<SMFSource> _midi_write_source;
 
 	std::list<std::shared_ptr<Source> >            _last_capture_sources;
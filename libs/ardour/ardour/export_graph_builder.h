@@ -26,10 +26,11 @@
 #include "ardour/export_analysis.h"
 #include "ardour/export_smf_writer.h"
 
+#include "audiographer/general/worker_pool.h"
 #include "audiographer/utils/identity_vertex.h"
 
 #include <boost/ptr_container/ptr_list.hpp>
-#include <glibmm/threadpool.h>
+#include <glibmm/threads.h>
 
 namespace AudioGrapher {
 	class SampleRateConverter;
@@ -87,10 +88,24 @@ class LIBARDOUR_API ExportGraphBuilder
 
   public:
 
-	ExportGraphBuilder (Session const & session);
+	ExportGraphBuilder (Session const & session, std::shared_ptr<AudioGrapher::WorkerPool> pool = std::shared_ptr<AudioGrapher::WorkerPool> ());
 	~ExportGraphBuilder ();
 
 	samplecnt_t process (samplecnt_t samples, bool last_cycle);
+
+	/* Batched export of several timespans in a single pass.
+	 * Every export channel must only be read once per cycle, the data
+	 * is shared by the graphs of all timespans.
+	 */
+	typedef std::map<ExportChannelPtr, Buffer const*> ChannelBuffers;
+
+	void read_channels (ChannelBuffers&, samplecnt_t samples);
+	/** @return offset of the first sample to export, or -1 during pre-roll */
+	sampleoffset_t process_offset (samplecnt_t samples) const;
+	/** Process @param samples starting at @param off of data previously read by read_channels() */
+	void process (ChannelBuffers const&, sampleoffset_t off, samplecnt_t samples, bool last_cycle);
+
+	std::shared_ptr<AudioGrapher::WorkerPool> worker_pool () const { return _worker_pool; }
 	bool post_process (); // returns true when finished
 	bool need_postprocessing () const { return !intermediates.empty(); }
 	bool realtime() const { return _realtime; }
@@ -316,8 +331,8 @@ class LIBARDOUR_API ExportGraphBuilder
 	bool        _realtime;
 	samplecnt_t _master_align;
 
-	Glib::ThreadPool     thread_pool;
-	Glib::Threads::Mutex engine_request_lock;
+	std::shared_ptr<AudioGrapher::WorkerPool> _worker_pool;
+	Glib::Threads::Mutex                      engine_request_lock;
 };
 
 } // namespace ARDOUR
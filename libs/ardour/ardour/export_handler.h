@@ -26,6 +26,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include <boost/operators.hpp>
 
@@ -152,11 +153,32 @@ class LIBARDOUR_API ExportHandler : public ExportElementFactory, public sigc::tr
 	int  process_timespan (samplecnt_t samples);
 	int  post_process ();
 	void finish_timespan ();
+	void finish_timespan_configs ();
 
 	typedef std::pair<ConfigMap::iterator, ConfigMap::iterator> TimespanBounds;
 	ExportTimespanPtr     current_timespan;
 	TimespanBounds        timespan_bounds;
 
+	/* Batched export: several timespans that use the same channels
+	 * are rendered in a single engine pass, each with its own graph.
+	 */
+	struct BatchedTimespan {
+		BatchedTimespan (ExportTimespanPtr ts, std::shared_ptr<ExportGraphBuilder> gb)
+			: timespan (ts), graph_builder (gb), done (false) {}
+
+		ExportTimespanPtr                   timespan;
+		std::shared_ptr<ExportGraphBuilder> graph_builder;
+		bool                                done;
+	};
+
+	std::vector<BatchedTimespan> batch;
+	samplepos_t                  batch_end;
+
+	void collect_batch (std::vector<ExportTimespanPtr>&);
+	int  start_batch (std::vector<ExportTimespanPtr> const&);
+	int  process_batch (samplecnt_t samples);
+	void finish_batch ();
+
 	PBD::ScopedConnection process_connection;
 	samplepos_t           process_position;
 
@@ -25,6 +25,7 @@
 
 #include <atomic>
 #include <list>
+#include <map>
 #include <memory>
 #include <set>
 #include <string>
@@ -33,6 +34,7 @@
 
 #include "pbd/mpmc_queue.h"
 #include "pbd/semutils.h"
+#include "pbd/work_stealing_deque.h"
 
 #include "ardour/audio_backend.h"
 #include "ardour/libardour_visibility.h"
@@ -63,10 +65,28 @@ struct GraphChain {
 	bool plot (std::string const&) const;
 
 	node_list_t _nodes_rt;
-	/** Nodes that are not fed by any other nodes */
+	/** Nodes that are not fed by any other nodes, most critical first */
 	node_list_t _init_trigger_list;
 	/** The number of nodes that do not feed any other node */
 	int _n_terminal_nodes;
+
+	/** Re-order nodes using their current processing times, at most
+	 * once per second. Called from the process thread while the graph
+	 * is idle, does not allocate.
+	 */
+	void update_priorities ();
+
+private:
+	void   prioritize ();
+	double critical_path (node_ptr_t const&);
+	void   sort_by_priority ();
+
+	/** Cost (usec) of the most expensive path from a node to the end of the graph */
+	std::map<GraphNode const*, double> _critical_path;
+	/** All nodes, each one after all nodes that it feeds */
+	std::vector<GraphNode*> _downstream_first;
+	/** Time when priorities are due to be updated */
+	int64_t _next_update;
 };
 
 class LIBARDOUR_API Graph : public SessionHandleRef
@@ -87,6 +107,9 @@ public:
 	void trigger (ProcessNode* n);
 	void reached_terminal_node ();
 
+	/** true if a thread runs the nodes it triggered last-in, first-out */
+	bool lifo_trigger () const { return _work_stealing; }
+
 	/* called by virtual GraphNode::process() */
 	void process_one_route (Route* route);
 	void process_one_ioplug (IOPlug*);
@@ -101,13 +124,25 @@ private:
 	void reset_thread_list ();
 	void drop_threads ();
 	void run_one ();
+	bool pop_work (ProcessNode*&);
 	void main_thread ();
 	void prep ();
 
 	void helper_thread ();
 
 	PBD::MPMCQueue<ProcessNode*> _trigger_queue;      ///< nodes that can be processed
-	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue
+	std::atomic<uint32_t>        _trigger_queue_size; ///< number of entries in trigger-queue and thread-queues
+
+	typedef PBD::WorkStealingDeque<ProcessNode*> ThreadQueue;
+
+	/** Per-thread queues used by the work-stealing scheduler, indexed
+	 * by graph thread-id (0: main thread). A thread pushes the nodes
+	 * it triggers to its own queue and idle threads steal from others.
+	 */
+	std::vector<std::unique_ptr<ThreadQueue> > _thread_queues;
+
+	/** Scheduler used for the current cycle (set in prep) */
+	bool _work_stealing;
 
 	/** Start worker threads */
 	PBD::Semaphore _execution_sem;
@@ -131,7 +166,7 @@ private:
 	std::atomic<int> _terminate;
 
 	/* graph chain */
-	GraphChain const* _graph_chain;
+	GraphChain* _graph_chain;
 
 	/* parameter caches */
 	pframes_t   _process_nframes;
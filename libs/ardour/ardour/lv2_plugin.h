@@ -120,6 +120,7 @@ class LIBARDOUR_API LV2Plugin : public ARDOUR::Plugin, public ARDOUR::Workee
 	void cleanup ();
 
 	int set_block_size (pframes_t);
+	pframes_t max_block_size () const;
 	bool requires_fixed_sized_buffers () const;
 	bool connect_all_audio_outputs () const;
 
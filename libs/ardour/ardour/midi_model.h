@@ -24,6 +24,7 @@
 #ifndef __ardour_midi_model_h__
 #define __ardour_midi_model_h__
 
+#include <atomic>
 #include <deque>
 #include <map>
 #include <queue>
@@ -150,6 +151,9 @@ public:
 
 		std::set<NotePtr> side_effect_removals;
 
+		void edited_span (TimeType& start, TimeType& end) const;
+		void note_edits_done ();
+
 		XMLNode &marshal_change(const NoteChange&) const;
 		NoteChange unmarshal_change(XMLNode *xml_note);
 
@@ -311,6 +315,21 @@ public:
 	PBD::Signal0<void> ContentsChanged;
 	PBD::Signal1<void, Temporal::timecnt_t> ContentsShifted;
 
+	/** Number of content changes, incremented before ContentsChanged is emitted */
+	uint64_t edit_generation () const { return _edit_generation.load (); }
+
+	/** Find the span of time (in model time) that was changed by edits
+	 * since the given edit-generation.
+	 * @return false if the span is not known, e.g. when edits other than
+	 * note-diffs were made, or too many edits happened since.
+	 */
+	bool edited_span (uint64_t generation, TimeType& start, TimeType& end) const;
+
+	/** Record that notes in the given span of time were changed */
+	void notes_edited (TimeType const& start, TimeType const& end);
+	/** Record that the model's content changed in an unspecified way */
+	void contents_edited ();
+
 	std::shared_ptr<Evoral::Note<TimeType> > find_note (NotePtr);
 	PatchChangePtr find_patch_change (Evoral::event_id_t);
 	std::shared_ptr<Evoral::Note<TimeType> > find_note (Evoral::event_id_t);
@@ -364,6 +383,19 @@ private:
 	MidiSource& _midi_source;
 	InsertMergePolicy _insert_merge_policy;
 
+	struct EditSpan {
+		EditSpan (uint64_t g, TimeType const& s, TimeType const& e, bool k)
+			: generation (g), start (s), end (e), known (k) {}
+		uint64_t generation;
+		TimeType start;
+		TimeType end;
+		bool     known;
+	};
+
+	std::deque<EditSpan>         _edit_spans;
+	mutable Glib::Threads::Mutex _edit_span_lock;
+	std::atomic<uint64_t>        _edit_generation;
+
 	typedef std::map<void*,superclock_t> TempoMappingStash;
 	TempoMappingStash tempo_mapping_stash;
 
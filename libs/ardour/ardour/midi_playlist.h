@@ -25,11 +25,14 @@
 
 #include <vector>
 #include <list>
+#include <map>
 
 #include <boost/utility.hpp>
 
 #include "evoral/Parameter.h"
 
+#include "temporal/tempo.h"
+
 #include "ardour/ardour.h"
 #include "ardour/midi_cursor.h"
 #include "ardour/midi_model.h"
@@ -71,7 +74,11 @@ public:
 
 	~MidiPlaylist ();
 
-	void render (MidiChannelFilter*);
+	/** Render all regions into the RTMidiBuffer.
+	 * @param incremental if true, and only a limited time-range changed
+	 * since the last render, only re-render that range.
+	 */
+	void render (MidiChannelFilter*, bool incremental = true);
 	RTMidiBuffer* rendered();
 
 	int set_state (const XMLNode&, int version);
@@ -93,6 +100,37 @@ public:
 	NoteMode     _note_mode;
 
 	RTMidiBuffer _rendered;
+
+	/* state of each region at the time of the last render */
+	struct RenderedRegion {
+		std::weak_ptr<MidiRegion> region;
+		MidiModel const*          model;
+		uint64_t                  model_generation;
+		samplepos_t               first; // position
+		samplepos_t               last;  // end, notes are resolved here
+		timepos_t                 start;
+		layer_t                   layer;
+		bool                      opaque;
+		bool                      muted;
+	};
+
+	typedef std::map<MidiRegion const*, RenderedRegion> RenderedRegions;
+
+	struct RenderState {
+		RenderState () : valid (false), note_mode (Sustained), filter (0), filter_mode_mask (0) {}
+
+		bool                          valid;
+		NoteMode                      note_mode;
+		MidiChannelFilter*            filter;
+		uint32_t                      filter_mode_mask;
+		Temporal::TempoMap::SharedPtr tempo_map;
+		RenderedRegions               regions;
+	};
+
+	RenderState _render_state;
+
+	void render_state (std::list<std::shared_ptr<MidiRegion>> const&, MidiChannelFilter*, RenderState&) const;
+	bool render_changes (std::list<std::shared_ptr<MidiRegion>> const&, RenderState const&, MidiChannelFilter*);
 };
 
 } /* namespace ARDOUR */
@@ -34,6 +34,8 @@ extern "C" {
 }
 
 LIBARDOUR_API void x86_sse_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API float x86_sse_apply_gain_ramp_to_buffer   (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_sse_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
 
 extern "C" {
 /* AVX functions */
@@ -49,6 +51,8 @@ extern "C" {
 #ifdef PLATFORM_WINDOWS
 LIBARDOUR_API void x86_sse_avx_find_peaks               (float const* buf, uint32_t nsamples, float* min, float* max);
 #endif
+LIBARDOUR_API float x86_sse_avx_apply_gain_ramp_to_buffer   (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_sse_avx_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
 
 /* FMA functions */
 #ifdef FPU_AVX_FMA_SUPPORT
@@ -63,6 +67,8 @@ LIBARDOUR_API void  x86_avx512f_mix_buffers_with_gain   (float* dst, float const
 LIBARDOUR_API void  x86_avx512f_mix_buffers_no_gain     (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_copy_vector             (float* dst, float const* src, uint32_t nframes);
 LIBARDOUR_API void  x86_avx512f_find_peaks              (float const* buf, uint32_t nsamples, float* min, float* max);
+LIBARDOUR_API float x86_avx512f_apply_gain_ramp_to_buffer   (float* buf, uint32_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  x86_avx512f_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
 #endif
 
 /* debug wrappers for SSE functions */
@@ -82,6 +88,7 @@ LIBARDOUR_API void  veclib_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDOU
 LIBARDOUR_API void  veclib_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  veclib_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  veclib_find_peaks                (ARDOUR::Sample const* buf, ARDOUR::pframes_t nsamples, float* min, float* max);
+LIBARDOUR_API void  veclib_apply_gain_vector_to_buffer (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
 
 #endif
 
@@ -94,6 +101,8 @@ extern "C" {
 	LIBARDOUR_API void  arm_neon_find_peaks            (float const* src, uint32_t nframes, float* minf, float* maxf);
 	LIBARDOUR_API void  arm_neon_mix_buffers_no_gain   (float* dst, float const* src, uint32_t nframes);
 	LIBARDOUR_API void  arm_neon_mix_buffers_with_gain (float* dst, float const* src, uint32_t nframes, float gain);
+	LIBARDOUR_API float arm_neon_apply_gain_ramp_to_buffer   (float* buf, uint32_t nframes, float initial, float target, float coeff);
+	LIBARDOUR_API void  arm_neon_apply_gain_vector_to_buffer (float* buf, float const* gain, uint32_t nframes);
 }
 #endif
 
@@ -105,5 +114,7 @@ LIBARDOUR_API void  default_apply_gain_to_buffer      (ARDOUR::Sample* buf, ARDO
 LIBARDOUR_API void  default_mix_buffers_with_gain     (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes, float gain);
 LIBARDOUR_API void  default_mix_buffers_no_gain       (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
 LIBARDOUR_API void  default_copy_vector               (ARDOUR::Sample* dst, ARDOUR::Sample const* src, ARDOUR::pframes_t nframes);
+LIBARDOUR_API float default_apply_gain_ramp_to_buffer   (ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float initial, float target, float coeff);
+LIBARDOUR_API void  default_apply_gain_vector_to_buffer (ARDOUR::Sample* buf, ARDOUR::gain_t const* gain, ARDOUR::pframes_t nframes);
 
 #endif /* __ardour_mix_h__ */
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_mmap_audio_file_h_
+#define _ardour_mmap_audio_file_h_
+
+#include <stdint.h>
+#include <string>
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+/** A read-only memory map of the sample data of an uncompressed,
+ * host-endian 32bit float WAV, RF64 or CAF file.
+ *
+ * This allows SndFileSource to de-interleave directly from the
+ * page-cache, bypassing libsndfile's read and seek calls and the
+ * intermediate interleave buffer.
+ *
+ * The map follows the direction of reads and uses madvise(2) to
+ * request read-ahead of the following (or, when reading backwards,
+ * preceding) pages.
+ *
+ * Only files that are not written to by Ardour are mapped. Another
+ * process may still truncate a mapped file, and accessing pages past
+ * its end raises SIGBUS. Accesses to the map are guarded by a SIGBUS
+ * handler that is installed when the first file is mapped, and a read
+ * that faults fails instead. This relies on the handler staying in place:
+ * if other code later replaces the process' SIGBUS action, such a fault
+ * terminates the process.
+ */
+class LIBARDOUR_API MMapAudioFile
+{
+public:
+	/** Map the given file, if it is supported.
+	 * @param path file to map
+	 * @param channels expected number of interleaved channels
+	 * @param frames expected number of sample-frames
+	 * @return new map or 0 if the file is not suitable or cannot be mapped
+	 */
+	static MMapAudioFile* open (std::string const& path, uint32_t channels, samplecnt_t frames);
+
+	~MMapAudioFile ();
+
+	uint32_t    channels () const { return _channels; }
+	samplecnt_t frames () const { return _frames; }
+
+	/** Copy (and de-interleave) @param cnt samples of channel @param chn
+	 * starting at @param start, applying @param gain.
+	 * The caller guarantees that the range is within the file.
+	 * @return false if the file was truncated and the map cannot be used, the
+	 * caller then needs to read the file by other means
+	 */
+	bool read (Sample* dst, samplepos_t start, samplecnt_t cnt, uint32_t chn, float gain) const;
+
+private:
+	MMapAudioFile (uint8_t const* addr, size_t len, size_t data_offset, uint32_t channels, samplecnt_t frames);
+
+	void copy (Sample* dst, samplepos_t start, samplecnt_t cnt, uint32_t chn, float gain) const;
+	void advise (samplepos_t start, samplecnt_t cnt) const;
+
+	static bool parse_riff (uint8_t const* addr, size_t len, size_t& offset, uint64_t& size, uint32_t& channels);
+	static bool parse_caf (uint8_t const* addr, size_t len, size_t& offset, uint64_t& size, uint32_t& channels);
+
+	uint8_t const* _addr;
+	size_t         _length;
+	float const*   _data;
+	uint32_t       _channels;
+	samplecnt_t    _frames;
+
+	mutable samplepos_t _last_read;
+	mutable samplepos_t _advised_start;
+	mutable samplepos_t _advised_end;
+	mutable bool        _reverse;
+	mutable bool        _failed;
+};
+
+} // namespace ARDOUR
+
+#endif /* _ardour_mmap_audio_file_h_ */
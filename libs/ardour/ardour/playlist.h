@@ -59,6 +59,7 @@ namespace ARDOUR {
 class Session;
 class Playlist;
 class Crossfade;
+class RegionIndex;
 class Track;
 
 namespace Properties {
@@ -333,6 +334,7 @@ protected:
 
 		~RegionWriteLock ()
 		{
+			playlist->invalidate_region_index ();
 			Glib::Threads::RWLock::WriterLock::release ();
 			thawlist.release ();
 			if (block_notify) {
@@ -404,6 +406,18 @@ protected:
 
 	std::shared_ptr<RegionList> regions_touched_locked (timepos_t const & start, timepos_t const & end);
 
+	/* Caller must hold the region lock. Returns an empty pointer for
+	 * playlists too small to benefit from an index.
+	 */
+	std::shared_ptr<RegionIndex const> region_index () const;
+	void invalidate_region_index ();
+
+	/** @return a counter that is incremented whenever regions are added,
+	 * removed, modified or re-layered. Derived classes can use this to
+	 * invalidate data computed from the region list.
+	 */
+	uint64_t region_generation () const { return _region_index_generation.load (); }
+
 	void notify_region_removed (std::shared_ptr<Region>);
 	void notify_region_added (std::shared_ptr<Region>);
 	void notify_layering_changed ();
@@ -474,6 +488,14 @@ private:
 	std::shared_ptr<RegionList> find_regions_at (timepos_t const &);
 
 	mutable boost::optional<std::pair<timepos_t, timepos_t> > _cached_extent;
+
+	/* lazily (re)built interval index over `regions', shared by all
+	 * readers. Any modification bumps the generation, which marks
+	 * the current index stale.
+	 */
+	mutable std::shared_ptr<RegionIndex const> _region_index;
+	std::atomic<uint64_t>                      _region_index_generation;
+
 	timepos_t _end_space;  //this is used when we are pasting a range with extra space at the end
 	bool _playlist_shift_active;
 
@@ -176,6 +176,11 @@ public:
 	virtual samplecnt_t max_latency () const { return 0; }
 
 	virtual int  set_block_size (pframes_t nframes) = 0;
+	/** @return the largest block size that the plugin can be set to
+	 * with set_block_size() after it was instantiated, 0 if the plugin
+	 * may only be used with the engine's buffer sizes.
+	 */
+	virtual pframes_t max_block_size () const { return 0; }
 	virtual bool requires_fixed_sized_buffers () const { return false; }
 	virtual bool inplace_broken () const { return false; }
 	virtual bool connect_all_audio_outputs () const { return false; }
@@ -0,0 +1,63 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef _ardour_plugin_cache_stamp_h_
+#define _ardour_plugin_cache_stamp_h_
+
+#include <stdint.h>
+#include <string>
+
+#include "pbd/gstdio_compat.h"
+#include "pbd/xml++.h"
+
+/* Used by the VST2 and VST3 cache-file code, which is compiled both into
+ * libardour and into the stand-alone scanner applications.
+ */
+
+namespace ARDOUR {
+
+/** Store size and mtime of the plugin module when a cache file is written.
+ *
+ * This detects plugins that were replaced by a file with an older timestamp
+ * (e.g. a downgrade), which a plain mtime comparison misses.
+ */
+static inline void
+set_plugin_module_stamp (XMLNode* root, std::string const& module_path)
+{
+	GStatBuf sb;
+	if (g_stat (module_path.c_str(), &sb) == 0) {
+		root->set_property ("module-size", (int64_t) sb.st_size);
+		root->set_property ("module-mtime", (int64_t) sb.st_mtime);
+	}
+}
+
+/** Check a cache file's module stamp against the module's current stat. */
+static inline bool
+plugin_module_stamp_matches (XMLNode const* root, GStatBuf const& sb)
+{
+	int64_t size, mtime;
+	if (!root->get_property ("module-size", size) || !root->get_property ("module-mtime", mtime)) {
+		/* cache file written by an older version */
+		return true;
+	}
+	return size == (int64_t) sb.st_size && mtime == (int64_t) sb.st_mtime;
+}
+
+} // namespace ARDOUR
+
+#endif /* _ardour_plugin_cache_stamp_h_ */
@@ -350,6 +350,7 @@ private:
 	bool vst2_plugin (std::string const& module_path, ARDOUR::PluginType, VST2Info const&);
 	bool run_vst2_scanner_app (std::string bundle_path, PSLEPtr) const;
 	int vst2_discover (std::string path, ARDOUR::PluginType, bool cache_only = false);
+	void vst2_scan_parallel (std::vector<std::string> const&, ARDOUR::PluginType, std::set<std::string>&);
 #endif
 
 	int vst3_discover_from_path (std::string const& path, bool cache_only = false);
@@ -357,6 +358,13 @@ private:
 #ifdef VST3_SUPPORT
 	void vst3_plugin (std::string const&, std::string const&, VST3Info const&);
 	bool run_vst3_scanner_app (std::string bundle_path, PSLEPtr) const;
+	void vst3_scan_parallel (std::vector<std::string> const&, std::set<std::string>&);
+#endif
+
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+	struct ScannerJob;
+	size_t scanner_jobs () const;
+	void   run_scanner_jobs (std::string const& scanner_bin, std::string const& type, std::list<ScannerJob>&);
 #endif
 
 	int ladspa_discover (std::string path);
@@ -89,6 +89,18 @@ class LIBARDOUR_API BackendPort : public ProtoPort
 		return _connections;
 	}
 
+	typedef std::vector<BackendPort*>         PortSources;
+	typedef std::shared_ptr<PortSources const> PortSourcesPtr;
+
+	/* Connected ports as plain pointers, for use in the process thread
+	 * when summing input buffers. The list is rebuilt when connections
+	 * change, and published via RCU, so the process thread does not
+	 * allocate.
+	 */
+	PortSourcesPtr get_sources () const {
+		return _sources.reader ();
+	}
+
 	int  connect (BackendPortHandle port, BackendPortHandle self);
 	int  disconnect (BackendPortHandle port, BackendPortHandle self);
 	void disconnect_all (BackendPortHandle self);
@@ -116,8 +128,11 @@ private:
 	LatencyRange           _playback_latency_range;
 	std::set<BackendPortPtr> _connections;
 
+	SerializedRCUManager<PortSources> _sources;
+
 	void store_connection (BackendPortHandle);
 	void remove_connection (BackendPortHandle);
+	void update_sources ();
 
 }; // class BackendPort
 
@@ -243,6 +258,12 @@ protected:
 		return (*it).second;
 	}
 
+	/* all ports of a shared backend are BackendPorts, so a handle
+	 * can be resolved without RTTI, or copying the shared_ptr */
+	static BackendPort* backend_port (PortEngine::PortHandle port) {
+		return static_cast<BackendPort*> (port.get ());
+	}
+
 	virtual BackendPort* port_factory (std::string const& name, ARDOUR::DataType dt, ARDOUR::PortFlags flags) = 0;
 
 #ifndef NDEBUG
@@ -441,7 +441,12 @@ public:
 	virtual std::shared_ptr<Region> get_parent() const;
 
 	uint64_t layering_index () const { return _layering_index; }
-	void set_layering_index (uint64_t when) { _layering_index = when; }
+	void set_layering_index (uint64_t when) {
+		if (_layering_index != when) {
+			_layering_index = when;
+			mark_state_changed ();
+		}
+	}
 
 	virtual bool is_dependent() const { return false; }
 	virtual bool depends_on (std::shared_ptr<Region> /*other*/) const { return false; }
@@ -673,6 +678,13 @@ private:
 	std::atomic<int>          _source_deleted;
 	Glib::Threads::Mutex      _source_list_lock;
 	PBD::ScopedConnectionList _source_deleted_connections;
+
+	/* state of the region as of _state_cache_generation, see get_state() */
+	bool state_cacheable () const;
+
+	mutable Glib::Threads::Mutex     _state_cache_lock;
+	mutable std::unique_ptr<XMLNode> _state_cache;
+	mutable uint64_t                 _state_cache_generation;
 };
 
 } /* namespace ARDOUR */
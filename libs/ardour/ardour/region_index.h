@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef __ardour_region_index_h__
+#define __ardour_region_index_h__
+
+#include <memory>
+#include <vector>
+
+#include "temporal/timeline.h"
+
+#include "ardour/libardour_visibility.h"
+#include "ardour/types.h"
+
+namespace ARDOUR {
+
+class Region;
+
+/** An immutable interval index over the regions of a playlist.
+ *
+ * Entries are kept in a vector sorted by region position. The vector is
+ * treated as an implicit balanced binary tree (the middle element of every
+ * sub-range is the root of that sub-range) and each node caches the
+ * maximum region-end found below it. This turns range and point lookups
+ * into O(log n + k) operations instead of a walk over the whole list.
+ *
+ * The index is a snapshot: region bounds are copied at build time, and the
+ * owning Playlist discards it whenever regions are added, removed or
+ * modified. Results are candidates only; callers still apply the exact
+ * Region::covers() or Region::coverage() test, so a stale index can never
+ * produce false positives.
+ */
+class LIBARDOUR_API RegionIndex
+{
+public:
+	RegionIndex (RegionList::const_iterator first, RegionList::const_iterator last, uint64_t generation);
+
+	uint64_t generation () const { return _generation; }
+	size_t   size () const { return _entries.size (); }
+
+	/** Collect all regions whose [position, nt_last] intersects the
+	 * inclusive range [@param start, @param last], in the order they
+	 * appear in the playlist's region list.
+	 */
+	void find (timepos_t const & start, timepos_t const & last, std::vector<std::shared_ptr<Region> >&) const;
+
+private:
+	struct Entry {
+		Entry (std::shared_ptr<Region> const &, uint32_t);
+
+		timepos_t               start;
+		timepos_t               last;
+		timepos_t               max_last; /* max of last in this sub-tree */
+		uint32_t                order;    /* position in the region list */
+		std::shared_ptr<Region> region;
+	};
+
+	struct EntrySorter {
+		bool operator() (Entry const & a, Entry const & b) const {
+			return a.start < b.start;
+		}
+	};
+
+	timepos_t build (size_t lo, size_t hi);
+	void      find (size_t lo, size_t hi, timepos_t const & start, timepos_t const & last, std::vector<Entry const*>&) const;
+
+	std::vector<Entry> _entries;
+	uint64_t           _generation;
+};
+
+} /* namespace ARDOUR */
+
+#endif /* __ardour_region_index_h__ */
@@ -28,6 +28,7 @@
 #include <glibmm/threads.h>
 
 #include "evoral/Event.h"
+#include "evoral/EventList.h"
 #include "evoral/EventSink.h"
 #include "evoral/midi_util.h"
 
@@ -62,6 +63,14 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	samplecnt_t span() const;
 
 	uint32_t write (TimeType time, Evoral::EventType type, uint32_t size, const uint8_t* buf);
+
+	/** Replace all events at or after @p start and before @p end with
+	 * the given events, which must be sorted and within the range.
+	 *
+	 * The caller must hold the WriteProtectRender lock. Blob storage
+	 * of replaced events is only reclaimed by clear().
+	 */
+	void splice (TimeType start, TimeType end, Evoral::EventList<TimeType> const& events);
 	uint32_t read (MidiBuffer& dst, samplepos_t start, samplepos_t end, MidiNoteTracker& tracker, samplecnt_t offset = 0);
 	void track (MidiStateTracker&, samplepos_t start, samplepos_t end);
 
@@ -119,6 +128,8 @@ class LIBARDOUR_API RTMidiBuffer : public Evoral::EventSink<samplepos_t>
 	bool   _reversed;
 	/* secondary blob storage. Holds Blobs (arbitrary size + data) */
 
+	void set_item (Item&, TimeType time, uint32_t size, const uint8_t* buf);
+
 	uint32_t alloc_blob (uint32_t size);
 	uint32_t store_blob (uint32_t size, uint8_t const * data);
 	uint32_t _pool_size;
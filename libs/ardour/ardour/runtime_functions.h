@@ -31,6 +31,8 @@ namespace ARDOUR {
 	typedef void  (*mix_buffers_with_gain_t) (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t, float);
 	typedef void  (*mix_buffers_no_gain_t)   (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
 	typedef void  (*copy_vector_t)           (ARDOUR::Sample *, const ARDOUR::Sample *, pframes_t);
+	typedef float (*apply_gain_ramp_to_buffer_t)   (ARDOUR::Sample *, pframes_t, float, float, float);
+	typedef void  (*apply_gain_vector_to_buffer_t) (ARDOUR::Sample *, const ARDOUR::gain_t *, pframes_t);
 
 	LIBARDOUR_API extern compute_peak_t          compute_peak;
 	LIBARDOUR_API extern find_peaks_t            find_peaks;
@@ -38,6 +40,14 @@ namespace ARDOUR {
 	LIBARDOUR_API extern mix_buffers_with_gain_t mix_buffers_with_gain;
 	LIBARDOUR_API extern mix_buffers_no_gain_t   mix_buffers_no_gain;
 	LIBARDOUR_API extern copy_vector_t           copy_vector;
+
+	/** Apply a gain that approaches @a target from @a initial with a
+	 * one-pole low-pass (coefficient @a coeff) per sample, as used for
+	 * declicking. Returns the gain after the last sample.
+	 */
+	LIBARDOUR_API extern apply_gain_ramp_to_buffer_t   apply_gain_ramp_to_buffer;
+	/** Multiply each sample with the corresponding gain coefficient */
+	LIBARDOUR_API extern apply_gain_vector_to_buffer_t apply_gain_vector_to_buffer;
 }
 
 #endif /* __ardour_runtime_functions_h__ */
@@ -111,6 +111,7 @@ namespace PBD {
 class Controllable;
 class Progress;
 class Command;
+class Thread;
 }
 
 namespace luabridge {
@@ -856,6 +857,16 @@ public:
 
 	int start_audio_export (samplepos_t position, bool realtime = false, bool region_export = false);
 
+	/** Temporarily increase the engine's buffer-size for a freewheel export.
+	 * This is only done if the backend allows it (see
+	 * AudioBackend::can_change_buffer_size_for_export) and all plugins
+	 * support the larger size (see Plugin::max_block_size).
+	 * The previous size is restored by finalize_audio_export(), or
+	 * when called with a size of 0.
+	 * @return true if the buffer-size was changed
+	 */
+	bool set_export_block_size (pframes_t);
+
 	PBD::Signal1<int, samplecnt_t> ProcessExport;
 	static PBD::Signal4<void, std::string, std::string, bool, samplepos_t> Exported;
 
@@ -1590,6 +1601,8 @@ private:
 	void finalize_audio_export (TransportRequestSource trs);
 	void finalize_export_internal (bool stop_freewheel);
 	bool _pre_export_mmc_enabled;
+	pframes_t _pre_export_block_size;
+	pframes_t max_plugin_block_size () const;
 
 	PBD::ScopedConnection export_freewheel_connection;
 
@@ -1633,6 +1646,9 @@ private:
 	std::atomic<int>  _suspend_save;
 	volatile bool      _save_queued;
 	volatile bool      _save_queued_pending;
+	PBD::Thread*       _pending_save_thread;
+
+	void wait_for_pending_save ();
 
 	Glib::Threads::Mutex save_state_lock;
 	Glib::Threads::Mutex save_source_lock;
@@ -36,6 +36,8 @@ namespace PBD {
 
 namespace ARDOUR {
 
+class MMapAudioFile;
+
 class LIBARDOUR_API SndFileSource : public AudioFileSource {
   public:
 	/** Constructor to be called for existing external-to-session files */
@@ -91,6 +93,10 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 	SNDFILE* _sndfile;
 	SF_INFO _info;
 	BroadcastInfo *_broadcast_info;
+	MMapAudioFile *_mmap;
+
+	class SharedReadBlock;
+	std::shared_ptr<SharedReadBlock> _read_block;
 
 	void init_sndfile ();
 	int open();
@@ -99,6 +105,14 @@ class LIBARDOUR_API SndFileSource : public AudioFileSource {
 
 	void set_natural_position (timepos_t const &);
 	samplecnt_t nondestructive_write_unlocked (Sample *dst, samplecnt_t cnt);
+
+	/* capture I/O hints (Linux only) */
+	int   _capture_fd;
+	off_t _preallocated;
+	off_t _writeback_pos;
+
+	void capture_io_hints ();
+	void release_preallocation ();
 	PBD::ScopedConnection header_position_connection;
 };
 
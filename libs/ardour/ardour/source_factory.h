@@ -57,9 +57,11 @@ public:
 	static std::vector<PBD::Thread*> peak_thread_pool;
 
 	static std::list<std::weak_ptr<AudioSource>> files_with_peaks;
+	static std::list<std::weak_ptr<AudioSource>> files_with_peak_levels;
 
-	static int peak_work_queue_length ();
-	static int setup_peakfile (std::shared_ptr<Source>, bool async);
+	static int  peak_work_queue_length ();
+	static int  setup_peakfile (std::shared_ptr<Source>, bool async);
+	static void build_peak_levels (std::shared_ptr<AudioSource>);
 };
 
 } // namespace ARDOUR
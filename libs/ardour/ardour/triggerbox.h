@@ -23,6 +23,7 @@
 
 #include <atomic>
 #include <map>
+#include <set>
 #include <vector>
 #include <string>
 #include <exception>
@@ -45,6 +46,8 @@
 #include "evoral/PatchChange.h"
 #include "evoral/SMF.h"
 
+#include "ardour/clip_sample_store.h"
+#include "ardour/clip_stream.h"
 #include "ardour/midi_model.h"
 #include "ardour/midi_state_tracker.h"
 #include "ardour/processor.h"
@@ -534,13 +537,21 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 	void retrigger ();
 
   private:
+	/* per-channel pointers into buffers shared with other triggers,
+	 * the data must not be modified.
+	 */
 	struct Data : std::vector<Sample*> {
 		samplecnt_t length;
+		samplecnt_t resident; /* samples in memory, the rest is streamed */
+		std::vector<ClipSampleStore::BufferPtr> buffers;
 
-		Data () : length (0) {}
+		Data () : length (0), resident (0) {}
 	};
 
 	Data        data;
+	ClipStream* _stream;
+	std::vector<Sample*> _stream_buf;
+	std::vector<Sample*> _clip_ptr;
 	RubberBand::RubberBandStretcher*  _stretcher;
 	samplepos_t _start_offset;
 
@@ -559,6 +570,7 @@ class LIBARDOUR_API AudioTrigger : public Trigger {
 
 	void drop_data ();
 	int load_data (std::shared_ptr<AudioRegion>);
+	Sample* const* clip_data (samplepos_t pos, samplecnt_t& cnt, bool from_stream = true);
 	void estimate_tempo ();
 	void reset_stretcher ();
 	void _startup (BufferSet&, pframes_t dest_offset, Temporal::BBT_Offset const &);
@@ -660,6 +672,13 @@ class LIBARDOUR_API TriggerBoxThread
 	void set_region (TriggerBox&, uint32_t slot, std::shared_ptr<Region>);
 	void request_delete_trigger (Trigger* t);
 
+	void add_stream (ClipStream*);
+	/** Stop refilling the given stream and delete it. Deletion is
+	 * deferred until the end of a refill cycle that is in progress.
+	 */
+	void remove_stream (ClipStream*);
+	void request_refill ();
+
 	void summon();
 	void stop();
 	void wait_until_finished();
@@ -671,7 +690,8 @@ class LIBARDOUR_API TriggerBoxThread
 	enum RequestType {
 		Quit,
 		SetRegion,
-		DeleteTrigger
+		DeleteTrigger,
+		Refill
 	};
 
 	struct Request {
@@ -699,6 +719,12 @@ class LIBARDOUR_API TriggerBoxThread
 	CrossThreadChannel _xthread;
 	void queue_request (Request*);
 	void delete_trigger (Trigger*);
+	void refill_streams ();
+
+	Glib::Threads::Mutex     _stream_lock;
+	std::set<ClipStream*>    _streams;
+	std::vector<ClipStream*> _dead_streams;
+	bool                     _refilling;
 };
 
 struct CueRecord {
@@ -426,6 +426,7 @@ public:
 	}
 
 	int set_block_size (pframes_t);
+	pframes_t max_block_size () const { return 8192; }
 
 	void set_owner (ARDOUR::SessionObject* o);
 	void set_non_realtime (bool);
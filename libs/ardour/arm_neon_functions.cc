@@ -515,4 +515,87 @@ arm_neon_copy_vector(
 	}
 }
 
+C_FUNC float
+arm_neon_apply_gain_ramp_to_buffer(float *dst, uint32_t nframes, float initial, float target, float coeff)
+{
+	const float r = 1.f - coeff;
+	float d = initial - target;
+
+	if (nframes >= 4) {
+		// Distance to target of 4 consecutive samples: d * r^k
+		float lanes[4];
+		double rk = 1.0;
+		for (int k = 0; k < 4; ++k) {
+			lanes[k] = d * rk;
+			rk *= r;
+		}
+
+		float32x4_t vd = vld1q_f32(lanes);
+		const float32x4_t vr = vdupq_n_f32((float)rk);
+		const float32x4_t vt = vdupq_n_f32(target);
+
+		while (nframes >= 4) {
+			float32x4_t x0;
+
+			x0 = vld1q_f32(dst);
+			x0 = vmulq_f32(x0, vaddq_f32(vt, vd));
+			vst1q_f32(dst, x0);
+			vd = vmulq_f32(vd, vr);
+
+			dst += 4;
+			nframes -= 4;
+		}
+
+		d = vgetq_lane_f32(vd, 0);
+	}
+
+	// Do the remaining samples
+	while (nframes > 0) {
+		*dst++ *= target + d;
+		d *= r;
+		--nframes;
+	}
+
+	return target + d;
+}
+
+C_FUNC void
+arm_neon_apply_gain_vector_to_buffer(float *dst, const float *gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		float32x4_t x0, x1;
+
+		x0 = vld1q_f32(dst + 0);
+		x1 = vld1q_f32(dst + 4);
+
+		x0 = vmulq_f32(x0, vld1q_f32(gain + 0));
+		x1 = vmulq_f32(x1, vld1q_f32(gain + 4));
+
+		vst1q_f32(dst + 0, x0);
+		vst1q_f32(dst + 4, x1);
+
+		dst += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes >= 4) {
+		float32x4_t x0;
+
+		x0 = vld1q_f32(dst);
+		x0 = vmulq_f32(x0, vld1q_f32(gain));
+		vst1q_f32(dst, x0);
+
+		dst += 4;
+		gain += 4;
+		nframes -= 4;
+	}
+
+	// Do the remaining samples
+	while (nframes > 0) {
+		*dst++ *= *gain++;
+		--nframes;
+	}
+}
+
 #endif
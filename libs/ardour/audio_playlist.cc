@@ -161,50 +161,43 @@ struct ReadSorter {
     }
 };
 
-/** A segment of region that needs to be read */
-struct Segment {
-	Segment (std::shared_ptr<AudioRegion> r, Temporal::Range a) : region (r), range (a) {}
-
-	std::shared_ptr<AudioRegion> region; ///< the region
-	Temporal::Range range;       ///< range of the region to read, in session samples
-};
-
-/** @param start Start position in session samples.
- *  @param cnt Number of samples to read.
+/** Compute (or look up) the regions and parts of regions that need to be
+ *  read for the range [@param start, @param end), in read order.
+ *  Caller must hold the region lock.
  */
-ARDOUR::timecnt_t
-AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, timepos_t const & start, timecnt_t const & cnt, uint32_t chan_n)
+std::shared_ptr<AudioPlaylist::ReadPlan const>
+AudioPlaylist::read_plan (timepos_t const & start, timepos_t const & end)
 {
-	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 read @ %2 for %3, channel %4, regions %5 mixdown @ %6 gain @ %7\n",
-							   name(), start, cnt, chan_n, regions.size(), mixdown_buffer, gain_buffer));
+	/* solo-selection depends on editor state, not on the playlist, do not cache */
+	bool const solo_selection = _session.solo_selection_active () && SoloSelectedActive ();
+	uint64_t const gen = region_generation ();
 
-	samplecnt_t const scnt (cnt.samples ());
+	std::shared_ptr<ReadPlan const> prev (std::atomic_load (&_read_plan));
 
-	/* optimizing this memset() away involves a lot of conditionals
-	   that may well cause more of a hit due to cache misses
-	   and related stuff than just doing this here.
-
-	   it would be great if someone could measure this
-	   at some point.
-
-	   one way or another, parts of the requested area
-	   that are not written to by Region::region_at()
-	   for all Regions that cover the area need to be
-	   zeroed.
-	*/
+	if (!solo_selection && prev && prev->generation == gen && prev->start <= start && end <= prev->end) {
+		return prev;
+	}
 
-	memset (buf, 0, sizeof (Sample) * scnt);
+	std::shared_ptr<ReadPlan> plan (new ReadPlan);
 
-	/* this function is never called from a realtime thread, so
-	   its OK to block (for short intervals).
-	*/
+	plan->generation = gen;
+	plan->start      = start;
+	plan->end        = end;
 
-	Playlist::RegionReadLock rl (this);
+	if (!solo_selection) {
+		/* plan ahead for the next few reads, in the direction the disk-reader is moving */
+		samplecnt_t const ahead = 3 * start.distance (end).samples ();
+		if (prev && start < prev->start) {
+			plan->start = timepos_t (max<samplepos_t> (0, start.samples () - ahead));
+		} else {
+			plan->end = timepos_t (end.samples () + ahead);
+		}
+	}
 
 	/* Find all the regions that are involved in the bit we are reading,
 	   and sort them by descending layer and ascending position.
 	*/
-	std::shared_ptr<RegionList> all = regions_touched_locked (start, start + cnt);
+	std::shared_ptr<RegionList> all = regions_touched_locked (plan->start, plan->end);
 	all->sort (ReadSorter ());
 
 	/* This will be a list of the bits of our read range that we have
@@ -214,7 +207,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 	Temporal::RangeList done;
 
 	/* This will be a list of the bits of regions that we need to read */
-	list<Segment> to_do;
+	std::vector<Segment>& to_do (plan->segments);
 
 	/* Now go through the `all' list filling in `to_do' and `done' */
 	for (RegionList::iterator i = all->begin(); i != all->end(); ++i) {
@@ -226,7 +219,7 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 		}
 
 		/* check for the case of solo_selection */
-		const bool force_transparent = (_session.solo_selection_active() && SoloSelectedActive() && !SoloSelectedListIncludes( (const Region*) &(**i)));
+		const bool force_transparent = (solo_selection && !SoloSelectedListIncludes( (const Region*) &(**i)));
 		if (force_transparent) {
 			continue;
 		}
@@ -235,8 +228,8 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 		   first, trim to the range we are reading...
 		*/
 		Temporal::Range rrange = ar->range_samples ();
-		Temporal::Range region_range (max (rrange.start(), start),
-		                              min (rrange.end(), start + cnt));
+		Temporal::Range region_range (max (rrange.start(), plan->start),
+		                              min (rrange.end(), plan->end));
 
 		/* ... and then remove the bits that are already done */
 
@@ -265,17 +258,72 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 		}
 	}
 
-	/* Now go backwards through the to_do list doing the actual reads */
+	/* the topmost regions are read last */
+	std::reverse (to_do.begin (), to_do.end ());
+
+	if (!solo_selection) {
+		std::atomic_store (&_read_plan, std::shared_ptr<ReadPlan const> (plan));
+	}
+
+	return plan;
+}
+
+/** @param start Start position in session samples.
+ *  @param cnt Number of samples to read.
+ */
+ARDOUR::timecnt_t
+AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, timepos_t const & start, timecnt_t const & cnt, uint32_t chan_n)
+{
+	DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("Playlist %1 read @ %2 for %3, channel %4, regions %5 mixdown @ %6 gain @ %7\n",
+							   name(), start, cnt, chan_n, regions.size(), mixdown_buffer, gain_buffer));
+
+	samplecnt_t const scnt (cnt.samples ());
+
+	/* optimizing this memset() away involves a lot of conditionals
+	   that may well cause more of a hit due to cache misses
+	   and related stuff than just doing this here.
+
+	   it would be great if someone could measure this
+	   at some point.
+
+	   one way or another, parts of the requested area
+	   that are not written to by Region::region_at()
+	   for all Regions that cover the area need to be
+	   zeroed.
+	*/
+
+	memset (buf, 0, sizeof (Sample) * scnt);
+
+	/* this function is never called from a realtime thread, so
+	   its OK to block (for short intervals).
+	*/
+
+	Playlist::RegionReadLock rl (this);
+
+	timepos_t const end (start + cnt);
+
+	std::shared_ptr<ReadPlan const> plan = read_plan (start, end);
+
+	/* The plan may cover a larger range, clip segments to the range we are reading.
+	 * This yields the same result as computing the plan for just this range,
+	 * since trimming commutes with the range subtractions in read_plan().
+	 */
+	for (auto const & seg : plan->segments) {
+
+		Temporal::Range const r (max (seg.range.start (), start), min (seg.range.end (), end));
+
+		if (r.end () <= r.start ()) {
+			continue;
+		}
 
-	for (list<Segment>::reverse_iterator i = to_do.rbegin(); i != to_do.rend(); ++i) {
 		DEBUG_TRACE (DEBUG::AudioPlayback, string_compose ("\tPlaylist %1 read %2 @ %3 for %4, channel %5, buf @ %6 offset %7\n",
-		                                                   name(), i->region->name(), i->range.start(),
-		                                                   i->range.length(), (int) chan_n,
-		                                                   buf, i->range.start().earlier (start)));
+		                                                   name(), seg.region->name(), r.start(),
+		                                                   r.length(), (int) chan_n,
+		                                                   buf, r.start().earlier (start)));
 
-		samplepos_t read_pos (i->range.start().samples());
-		samplecnt_t read_cnt (i->range.start().distance (i->range.end()).samples());
-		samplecnt_t soffset = start.distance (i->range.start()).samples();
+		samplepos_t read_pos (r.start().samples());
+		samplecnt_t read_cnt (r.start().distance (r.end()).samples());
+		samplecnt_t soffset = start.distance (r.start()).samples();
 
 		assert (soffset < scnt);
 
@@ -283,10 +331,10 @@ AudioPlaylist::read (Sample *buf, Sample *mixdown_buffer, float *gain_buffer, ti
 			read_cnt = scnt - soffset;
 		}
 		assert (soffset + read_cnt <= scnt);
-		samplecnt_t nread = i->region->read_at (buf + soffset, mixdown_buffer, gain_buffer, read_pos, read_cnt, chan_n);
+		samplecnt_t nread = seg.region->read_at (buf + soffset, mixdown_buffer, gain_buffer, read_pos, read_cnt, chan_n);
 		if (nread != read_cnt) {
-			std::cerr << name() << " tried to read " << read_cnt << " from " << nread << " in " << i->region->name() << " using range "
-			          << i->range.start() << " .. " << i->range.end() << " len " << i->range.length() << std::endl;
+			std::cerr << name() << " tried to read " << read_cnt << " from " << nread << " in " << seg.region->name() << " using range "
+			          << r.start() << " .. " << r.end() << " len " << r.length() << std::endl;
 #ifndef NDEBUG
 			/* forward error to DiskReader::audio_read. This does 2 things:
 			 *  - error "DiskReader %1: when refilling, cannot read ..."
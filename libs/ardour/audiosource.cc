@@ -63,6 +63,7 @@
 #include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/session.h"
+#include "ardour/source_factory.h"
 
 #include "pbd/i18n.h"
 
@@ -79,17 +80,32 @@ bool AudioSource::_build_peakfiles = false;
 
 #define _FPP 256
 
+/* each reduced peak level combines this many peaks of the level below */
+#define _PEAK_LEVEL_FACTOR 4
+
+static samplecnt_t
+peak_level_fpp (uint32_t level)
+{
+	samplecnt_t fpp = _FPP;
+	while (level--) {
+		fpp *= _PEAK_LEVEL_FACTOR;
+	}
+	return fpp;
+}
+
 AudioSource::AudioSource (Session& s, const string& name)
 	: Source (s, DataType::AUDIO, name)
 	, _peak_byte_max (0)
 	, _peaks_built (false)
 	, _peakfile_fd (-1)
+	, _peak_levels_valid (-1)
 	, peak_leftover_cnt (0)
 	, peak_leftover_size (0)
 	, peak_leftovers (0)
 	, peak_leftover_sample (0)
 	, _first_run (true)
 	, _last_scale (0.0)
+	, _last_fpp (0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
 {
@@ -100,12 +116,14 @@ AudioSource::AudioSource (Session& s, const XMLNode& node)
 	, _peak_byte_max (0)
 	, _peaks_built (false)
 	, _peakfile_fd (-1)
+	, _peak_levels_valid (-1)
 	, peak_leftover_cnt (0)
 	, peak_leftover_size (0)
 	, peak_leftovers (0)
 	, peak_leftover_sample (0)
 	, _first_run (true)
 	, _last_scale (0.0)
+	, _last_fpp (0)
 	, _last_map_off (0)
 	, _last_raw_map_length (0)
 {
@@ -130,6 +148,12 @@ AudioSource::~AudioSource ()
 		_peakfile_fd = -1;
 	}
 
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		if (-1 != _peak_level[l].fd) {
+			close (_peak_level[l].fd);
+		}
+	}
+
 	delete [] peak_leftovers;
 }
 
@@ -211,12 +235,20 @@ AudioSource::touch_peakfile ()
 	tbuf.modtime = time ((time_t*) 0);
 
 	g_utime (_peakpath.c_str(), &tbuf);
+
+	for (uint32_t l = 1; l <= n_peak_levels; ++l) {
+		std::string const path = peak_level_path (_peakpath, l);
+		if (Glib::file_test (path, Glib::FILE_TEST_EXISTS)) {
+			g_utime (path.c_str(), &tbuf);
+		}
+	}
 }
 
 int
 AudioSource::rename_peakfile (string newpath)
 {
 	/* caller must hold _lock */
+	Glib::Threads::RecMutex::Lock lm (_peak_levels_lock);
 
 	string oldpath = _peakpath;
 
@@ -227,11 +259,42 @@ AudioSource::rename_peakfile (string newpath)
 		}
 	}
 
+	for (uint32_t l = 1; l <= n_peak_levels; ++l) {
+		std::string const path = peak_level_path (oldpath, l);
+		if (Glib::file_test (path, Glib::FILE_TEST_EXISTS)) {
+			if (g_rename (path.c_str(), peak_level_path (newpath, l).c_str()) != 0) {
+				/* not fatal, levels are rebuilt on demand */
+				::g_unlink (path.c_str());
+			}
+		}
+	}
+
 	_peakpath = newpath;
+	_peak_levels_valid = -1;
 
 	return 0;
 }
 
+std::string
+AudioSource::peak_level_path (std::string const & peakpath, uint32_t level)
+{
+	if (level == 0) {
+		return peakpath;
+	}
+	return string_compose ("%1.%2", peakpath, level);
+}
+
+void
+AudioSource::unlink_peak_levels () const
+{
+	if (_peakpath.empty()) {
+		return;
+	}
+	for (uint32_t l = 1; l <= n_peak_levels; ++l) {
+		::g_unlink (peak_level_path (_peakpath, l).c_str());
+	}
+}
+
 int
 AudioSource::initialize_peakfile (const string& audio_path, const bool in_session)
 {
@@ -338,7 +401,54 @@ AudioSource::write (Sample *dst, samplecnt_t cnt)
 int
 AudioSource::read_peaks (PeakData *peaks, samplecnt_t npeaks, samplepos_t start, samplecnt_t cnt, double samples_per_visual_peak) const
 {
-	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, _FPP);
+	uint32_t level = usable_peak_level (samples_per_visual_peak);
+	return read_peaks_with_fpp (peaks, npeaks, start, cnt, samples_per_visual_peak, peak_level_fpp (level));
+}
+
+/** @return the coarsest peak level that can be used for the given zoom.
+ * Reduced levels are only used when they still provide at least two
+ * peaks per visual peak, so that read_peaks_with_fpp() only ever
+ * downsamples from them.
+ */
+uint32_t
+AudioSource::usable_peak_level (double samples_per_visual_peak) const
+{
+	if (samples_per_visual_peak < 2 * peak_level_fpp (1) || (_flags & NoPeakFile)) {
+		return 0;
+	}
+
+	if (-1 != _peakfile_fd) {
+		/* peaks are being written (e.g. capture), levels are not complete */
+		return 0;
+	}
+
+	int n_levels = _peak_levels_valid.load ();
+
+	if (n_levels < 0) {
+		{
+			Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
+			if (!_peaks_built) {
+				return 0;
+			}
+		}
+		/* levels may have to be computed from the peakfile, which
+		 * is done in the background. Until then use level 0.
+		 */
+		int not_checked = -1;
+		if (_peak_levels_valid.compare_exchange_strong (not_checked, -2)) {
+			std::shared_ptr<AudioSource> as (std::dynamic_pointer_cast<AudioSource> (const_cast<AudioSource*>(this)->shared_from_this ()));
+			SourceFactory::build_peak_levels (as);
+		}
+		return 0;
+	}
+
+	uint32_t level = 0;
+
+	while (level < (uint32_t) n_levels && 2 * peak_level_fpp (level + 1) <= samples_per_visual_peak) {
+		++level;
+	}
+
+	return level;
 }
 
 /** @param peaks Buffer to write peak data.
@@ -407,15 +517,25 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 	samplecnt_t read_npeaks = npeaks;
 	samplecnt_t zero_fill = 0;
 
+	/* reduced peak levels are validated when they are set up, see build_peak_levels() */
+	uint32_t level = 0;
+	while (level < n_peak_levels && peak_level_fpp (level) < samples_per_file_peak) {
+		++level;
+	}
+	if (peak_level_fpp (level) != samples_per_file_peak) {
+		level = 0;
+	}
+	std::string const peakpath (peak_level_path (_peakpath, level));
+
 	GStatBuf statbuf;
 
 	expected_peaks = (cnt / (double) samples_per_file_peak);
-	if (g_stat (_peakpath.c_str(), &statbuf) != 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), _peakpath, strerror (errno)) << endmsg;
+	if (g_stat (peakpath.c_str(), &statbuf) != 0) {
+		error << string_compose (_("Cannot open peakfile @ %1 for size check (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
-	if (!_captured_for.empty()) {
+	if (level == 0 && !_captured_for.empty()) {
 
 		/* _captured_for is only set after a capture pass is
 		 * complete. so we know that capturing is finished for this
@@ -446,10 +566,10 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		}
 	}
 
-	ScopedFileDescriptor sfd (g_open (_peakpath.c_str(), O_RDONLY, 0444));
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str(), O_RDONLY, 0444));
 
 	if (sfd < 0) {
-		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), _peakpath, strerror (errno)) << endmsg;
+		error << string_compose (_("Cannot open peakfile @ %1 for reading (%2)"), peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
 
@@ -509,7 +629,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		off_t  map_delta = map_off - read_map_off;
 		size_t map_length = bytes_to_read + map_delta;
 
-		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
+		if (_first_run  || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length  < bytes_to_read)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			char* addr;
 #ifdef PLATFORM_WINDOWS
@@ -556,6 +676,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = bytes_to_read;
 		}
@@ -602,7 +723,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 		size_t raw_map_length = chunksize * sizeof(PeakData);
 		size_t map_length = (chunksize * sizeof(PeakData)) + map_delta;
 
-		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
+		if (_first_run || (_last_scale != samples_per_visual_peak) || (_last_fpp != samples_per_file_peak) || (_last_map_off != map_off) || (_last_raw_map_length < raw_map_length)) {
 			peak_cache.reset (new PeakData[npeaks]);
 			boost::scoped_array<PeakData> staging (new PeakData[chunksize]);
 
@@ -674,6 +795,7 @@ AudioSource::read_peaks_with_fpp (PeakData *peaks, samplecnt_t npeaks, samplepos
 
 			_first_run = false;
 			_last_scale = samples_per_visual_peak;
+			_last_fpp = samples_per_file_peak;
 			_last_map_off = map_off;
 			_last_raw_map_length = raw_map_length;
 		}
@@ -848,8 +970,10 @@ AudioSource::close_peakfile ()
 		close (_peakfile_fd);
 		_peakfile_fd = -1;
 	}
+	done_with_peak_level_writes (false);
 	if (!_peakpath.empty()) {
 		::g_unlink (_peakpath.c_str());
+		unlink_peak_levels ();
 	}
 	_peaks_built = false;
 	return 0;
@@ -866,9 +990,275 @@ AudioSource::prepare_for_peakfile_writes ()
 		error << string_compose(_("AudioSource: cannot open _peakpath (c) \"%1\" (%2)"), _peakpath, strerror (errno)) << endmsg;
 		return -1;
 	}
+
+	prepare_for_peak_level_writes ();
+
 	return 0;
 }
 
+int
+AudioSource::prepare_for_peak_level_writes ()
+{
+	Glib::Threads::RecMutex::Lock lm (_peak_levels_lock);
+	int ret = 0;
+
+	_peak_levels_valid = -1;
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_level[l]);
+
+		pl.index    = -1;
+		pl.byte_max = 0;
+
+		if (-1 != pl.fd) {
+			continue;
+		}
+
+		std::string const path = peak_level_path (_peakpath, l + 1);
+
+		if ((pl.fd = g_open (path.c_str(), O_CREAT|O_RDWR, 0664)) == -1) {
+			/* not fatal, reads will use the full resolution peakfile */
+			DEBUG_TRACE (DEBUG::Peaks, string_compose ("cannot open peak level file %1 (%2)\n", path, strerror (errno)));
+			ret = -1;
+		}
+	}
+
+	return ret;
+}
+
+void
+AudioSource::done_with_peak_level_writes (bool done)
+{
+	Glib::Threads::RecMutex::Lock lm (_peak_levels_lock);
+	bool complete = done;
+
+	if (done) {
+		std::vector<IndexedPeak> none;
+		write_peak_levels (none, true);
+	}
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_level[l]);
+		if (-1 == pl.fd) {
+			complete = false;
+			continue;
+		}
+		close (pl.fd);
+		pl.fd    = -1;
+		pl.index = -1;
+	}
+
+	_peak_levels_valid = complete ? (int) n_peak_levels : -1;
+}
+
+/** Merge peaks (indexed at the resolution of the level below) into the
+ * reduced peak levels and write out every completed peak. @param peaks is
+ * used as scratch space. If @param flush is true, partially accumulated peaks
+ * are written as well.
+ */
+int
+AudioSource::write_peak_levels (std::vector<IndexedPeak>& peaks, bool flush)
+{
+	Glib::Threads::RecMutex::Lock lm (_peak_levels_lock);
+
+	std::vector<IndexedPeak> completed;
+	std::vector<PeakData>    run;
+	int                      ret = 0;
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_level[l]);
+
+		completed.clear ();
+
+		for (auto const& p : peaks) {
+			samplepos_t const index = p.index / _PEAK_LEVEL_FACTOR;
+
+			if (index == pl.index) {
+				pl.peak.max = max (pl.peak.max, p.peak.max);
+				pl.peak.min = min (pl.peak.min, p.peak.min);
+				continue;
+			}
+
+			if (pl.index >= 0) {
+				completed.push_back (IndexedPeak (pl.index, pl.peak));
+			}
+
+			pl.index = index;
+			pl.peak  = p.peak;
+		}
+
+		if (flush && pl.index >= 0) {
+			completed.push_back (IndexedPeak (pl.index, pl.peak));
+			pl.index = -1;
+		}
+
+		if (-1 != pl.fd) {
+
+			/* write runs of consecutive peaks */
+
+			for (size_t i = 0; i < completed.size ();) {
+				size_t n = 1;
+				while (i + n < completed.size () && completed[i + n].index == completed[i].index + (samplepos_t) n) {
+					++n;
+				}
+
+				run.clear ();
+				for (size_t k = i; k < i + n; ++k) {
+					run.push_back (completed[k].peak);
+				}
+
+				off_t   byte  = completed[i].index * sizeof (PeakData);
+				ssize_t bytes = n * sizeof (PeakData);
+
+				if (lseek (pl.fd, byte, SEEK_SET) != byte || ::write (pl.fd, &run[0], bytes) != bytes) {
+					DEBUG_TRACE (DEBUG::Peaks, string_compose ("%1: could not write peak level %2 (%3)\n", _name, l + 1, strerror (errno)));
+					close (pl.fd);
+					pl.fd = -1;
+					ret = -1;
+					break;
+				}
+
+				pl.byte_max = max (pl.byte_max, (off_t) (byte + bytes));
+				i += n;
+			}
+		}
+
+		peaks.swap (completed);
+	}
+
+	return ret;
+}
+
+void
+AudioSource::truncate_peak_levels ()
+{
+	Glib::Threads::RecMutex::Lock lm (_peak_levels_lock);
+
+	for (uint32_t l = 0; l < n_peak_levels; ++l) {
+		PeakLevel& pl (_peak_level[l]);
+		if (-1 == pl.fd) {
+			continue;
+		}
+		off_t end = lseek (pl.fd, 0, SEEK_END);
+		if (end > pl.byte_max) {
+			if (ftruncate (pl.fd, pl.byte_max)) {
+				/* error doesn't matter, reads are bounded by the source length */
+			}
+		}
+	}
+}
+
+/** Make sure reduced peak levels exist for an existing peakfile, either by
+ * checking the files on disk or by computing them from the peakfile.
+ * Only the peakfile itself is read, the audio data is not touched.
+ */
+int
+AudioSource::build_peak_levels ()
+{
+	std::string peakpath;
+
+	{
+		/* only to check the current state, _lock is not held while
+		 * building, so that concurrent read_peaks() are not blocked.
+		 */
+		WriterLock lp (_lock);
+
+		if (-1 != _peakfile_fd) {
+			/* peaks are being written, levels follow along */
+			int queued = -2;
+			_peak_levels_valid.compare_exchange_strong (queued, -1);
+			return -1;
+		}
+
+		peakpath = _peakpath;
+	}
+
+	Glib::Threads::RecMutex::Lock lm (_peak_levels_lock);
+
+	if (_peak_levels_valid.load () >= 0) {
+		return 0;
+	}
+
+	GStatBuf peakstat;
+
+	if (g_stat (peakpath.c_str(), &peakstat) != 0) {
+		_peak_levels_valid = 0;
+		return -1;
+	}
+
+	bool        valid  = true;
+	samplecnt_t npeaks = peakstat.st_size / sizeof (PeakData);
+
+	for (uint32_t l = 1; valid && l <= n_peak_levels; ++l) {
+		GStatBuf levelstat;
+		npeaks /= _PEAK_LEVEL_FACTOR;
+
+		if (g_stat (peak_level_path (peakpath, l).c_str(), &levelstat) != 0) {
+			valid = false;
+		} else if (levelstat.st_size < (off_t) (npeaks * sizeof (PeakData))) {
+			valid = false;
+		} else if (levelstat.st_mtime < peakstat.st_mtime && (peakstat.st_mtime - levelstat.st_mtime > 6)) {
+			/* allow the same slop as initialize_peakfile() */
+			valid = false;
+		}
+	}
+
+	if (valid) {
+		_peak_levels_valid = (int) n_peak_levels;
+		return 0;
+	}
+
+	DEBUG_TRACE (DEBUG::Peaks, string_compose ("Building peak levels for %1\n", peakpath));
+
+	ScopedFileDescriptor sfd (g_open (peakpath.c_str(), O_RDONLY, 0444));
+
+	if (sfd < 0 || prepare_for_peak_level_writes ()) {
+		done_with_peak_level_writes (false);
+		_peak_levels_valid = 0;
+		return -1;
+	}
+
+	const samplecnt_t           chunksize = 16384;
+	boost::scoped_array<PeakData> buf (new PeakData[chunksize]);
+	std::vector<IndexedPeak>    peaks;
+	samplepos_t                 index = 0;
+
+	peaks.reserve (chunksize);
+
+	while (true) {
+		ssize_t n = ::read (sfd, buf.get(), chunksize * sizeof (PeakData));
+		if (n <= 0) {
+			break;
+		}
+		peaks.clear ();
+		for (ssize_t i = 0; i < n / (ssize_t) sizeof (PeakData); ++i) {
+			peaks.push_back (IndexedPeak (index++, buf[i]));
+		}
+		if (write_peak_levels (peaks, false)) {
+			break;
+		}
+	}
+
+	{
+		std::vector<IndexedPeak> none;
+		write_peak_levels (none, true);
+	}
+
+	truncate_peak_levels ();
+	done_with_peak_level_writes (false);
+
+	bool complete = true;
+	for (uint32_t l = 1; l <= n_peak_levels; ++l) {
+		if (!Glib::file_test (peak_level_path (peakpath, l), Glib::FILE_TEST_EXISTS)) {
+			complete = false;
+		}
+	}
+
+	_peak_levels_valid = complete ? (int) n_peak_levels : 0;
+
+	return complete ? 0 : -1;
+}
+
 void
 AudioSource::done_with_peakfile_writes (bool done)
 {
@@ -877,6 +1267,7 @@ AudioSource::done_with_peakfile_writes (bool done)
 			close (_peakfile_fd);
 			_peakfile_fd = -1;
 		}
+		done_with_peak_level_writes (false);
 		return;
 	}
 
@@ -889,6 +1280,8 @@ AudioSource::done_with_peakfile_writes (bool done)
 		_peakfile_fd = -1;
 	}
 
+	done_with_peak_level_writes (done);
+
 	if (done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		_peaks_built = true;
@@ -955,6 +1348,11 @@ AudioSource::compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, sam
 
 			_peak_byte_max = max (_peak_byte_max, (off_t) (byte + sizeof(PeakData)));
 
+			if (fpp == _FPP) {
+				std::vector<IndexedPeak> level_peaks (1, IndexedPeak (peak_leftover_sample / fpp, x));
+				write_peak_levels (level_peaks, false);
+			}
+
 			{
 				Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 				PeakRangeReady (peak_leftover_sample, peak_leftover_cnt); /* EMIT SIGNAL */
@@ -1083,6 +1481,15 @@ AudioSource::compute_and_write_peaks (Sample* buf, samplecnt_t first_sample, sam
 
 	_peak_byte_max = max (_peak_byte_max, (off_t) (first_peak_byte + bytes_to_write));
 
+	if (fpp == _FPP && peaks_computed > 0) {
+		std::vector<IndexedPeak> level_peaks;
+		level_peaks.reserve (peaks_computed);
+		for (uint32_t n = 0; n < peaks_computed; ++n) {
+			level_peaks.push_back (IndexedPeak (first_sample / fpp + n, peakbuf[n]));
+		}
+		write_peak_levels (level_peaks, false);
+	}
+
 	if (samples_done) {
 		Glib::Threads::Mutex::Lock lm (_peaks_ready_lock);
 		PeakRangeReady (first_sample, samples_done); /* EMIT SIGNAL */
@@ -1114,6 +1521,8 @@ AudioSource::truncate_peakfile ()
 						 _peakpath, _peak_byte_max, errno) << endmsg;
 		}
 	}
+
+	truncate_peak_levels ();
 }
 
 samplecnt_t
@@ -20,6 +20,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <limits>
+
 #include <errno.h>
 #include <fcntl.h>
 #include <unistd.h>
@@ -28,6 +31,7 @@
 #include <poll.h>
 #endif
 
+#include "pbd/cpus.h"
 #include "pbd/error.h"
 #include "pbd/pthread_utils.h"
 
@@ -59,8 +63,15 @@ Butler::Butler (Session& s)
 	, _midi_buffer_size (0)
 	, pool_trash (16)
 	, _xthread (true)
+	, _next_job (0)
+	, _jobs_active (0)
+	, _job_errors (0)
+	, _jobs_outstanding (false)
+	, _workers_run (false)
 {
 	should_do_transport_work.store (0);
+	_summon_time.store (0);
+	reset_refill_latency ();
 	SessionEvent::pool->set_trash (&pool_trash);
 
 	/* catch future changes to parameters */
@@ -144,6 +155,8 @@ Butler::start_thread ()
 	//pthread_detach (thread);
 	have_thread = true;
 
+	start_workers ();
+
 	// we are ready to request buffer adjustments
 	_session.adjust_capture_buffering ();
 	_session.adjust_playback_buffering ();
@@ -159,7 +172,58 @@ Butler::terminate_thread ()
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: ask butler to quit @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time ()));
 		queue_request (Request::Quit);
 		pthread_join (thread, &status);
+		have_thread = false;
+	}
+
+	stop_workers ();
+}
+
+void
+Butler::start_workers ()
+{
+	uint32_t n_threads = Config->get_butler_threads ();
+
+	if (n_threads == 0) {
+		/* a few threads suffice to keep a slow write () on one track
+		 * from delaying the flushes of all others
+		 */
+		n_threads = 4;
+	}
+
+	n_threads = std::max<uint32_t> (1, std::min<uint32_t> (n_threads, hardware_concurrency ()));
+
+	Glib::Threads::Mutex::Lock lm (_job_lock);
+
+	_workers_run = true;
+
+	/* the butler thread itself is the first */
+	for (uint32_t n = 1; n < n_threads; ++n) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&Butler::worker_thread_work, this), string_compose ("butler worker %1", n));
+		if (!t) {
+			error << _("Session: could not create butler worker thread") << endmsg;
+			break;
+		}
+		_workers.push_back (t);
+	}
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler uses %1 worker threads\n", _workers.size ()));
+}
+
+void
+Butler::stop_workers ()
+{
+	{
+		Glib::Threads::Mutex::Lock lm (_job_lock);
+		_workers_run = false;
+		_job_available.broadcast ();
 	}
+
+	for (auto& t : _workers) {
+		t->join ();
+		delete t;
+	}
+
+	_workers.clear ();
 }
 
 void*
@@ -173,9 +237,8 @@ Butler::_thread_work (void* arg)
 void*
 Butler::thread_work ()
 {
-	uint32_t            err                   = 0;
-	bool                disk_work_outstanding = false;
-	RouteList::iterator i;
+	uint32_t err                   = 0;
+	bool     disk_work_outstanding = false;
 
 	while (true) {
 		DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 butler main loop, disk work outstanding ? %2 @ %3\n", DEBUG_THREAD_SELF, disk_work_outstanding, g_get_monotonic_time ()));
@@ -251,52 +314,19 @@ Butler::thread_work ()
 		RouteList rl_with_auditioner = *rl;
 		rl_with_auditioner.push_back (_session.the_auditioner ());
 
-		DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested ()));
-
-		for (i = rl_with_auditioner.begin (); !transport_work_requested () && should_run && i != rl_with_auditioner.end (); ++i) {
-			std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
-
-			if (!tr) {
-				continue;
-			}
-
-			std::shared_ptr<IO> io = tr->input ();
+		if (!_workers.empty ()) {
+			disk_work_outstanding = flush_and_refill_tracks_parallel (rl, rl_with_auditioner, err);
+		} else {
+			disk_work_outstanding = refill_tracks_normal (rl_with_auditioner);
 
-			if (io && !io->active ()) {
-				/* don't read inactive tracks */
-				// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
-				continue;
-			}
-			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
-			switch (tr->do_refill ()) {
-				case 0:
-					//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
-					break;
-
-				case 1:
-					DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
-					disk_work_outstanding = true;
-					break;
-
-				default:
-					error << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << endmsg;
-					std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << std::endl;
-					break;
+			if (!err && transport_work_requested ()) {
+				DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
+				goto restart;
 			}
-		}
 
-		if (i != rl_with_auditioner.begin () && i != rl_with_auditioner.end ()) {
-			/* we didn't get to all the streams */
-			disk_work_outstanding = true;
+			disk_work_outstanding = disk_work_outstanding || flush_tracks_to_disk_normal (rl, err);
 		}
 
-		if (!err && transport_work_requested ()) {
-			DEBUG_TRACE (DEBUG::Butler, "transport work requested during refill, back to restart\n");
-			goto restart;
-		}
-
-		disk_work_outstanding = disk_work_outstanding || flush_tracks_to_disk_normal (rl, err);
-
 		if (err && _session.actively_recording ()) {
 			/* stop the transport and try to catch as much possible
 			   captured state as we can.
@@ -323,6 +353,16 @@ Butler::thread_work ()
 				goto restart;
 			}
 
+			int64_t summoned = _summon_time.exchange (0);
+			if (summoned > 0) {
+				int64_t const dt = g_get_monotonic_time () - summoned;
+				Glib::Threads::Mutex::Lock ll (_latency_lock);
+				_latency_min  = std::min (_latency_min, dt);
+				_latency_max  = std::max (_latency_max, dt);
+				_latency_sum += dt;
+				++_latency_cnt;
+			}
+
 			DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: butler signals pause @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time ()));
 			paused.signal ();
 		}
@@ -335,6 +375,54 @@ Butler::thread_work ()
 	return (0);
 }
 
+bool
+Butler::refill_tracks_normal (RouteList const& rl)
+{
+	bool                      disk_work_outstanding = false;
+	RouteList::const_iterator i;
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler starts refill loop, twr = %1\n", transport_work_requested ()));
+
+	for (i = rl.begin (); !transport_work_requested () && should_run && i != rl.end (); ++i) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (*i);
+
+		if (!tr) {
+			continue;
+		}
+
+		std::shared_ptr<IO> io = tr->input ();
+
+		if (io && !io->active ()) {
+			/* don't read inactive tracks */
+			// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler skips inactive track %1\n", tr->name()));
+			continue;
+		}
+		// DEBUG_TRACE (DEBUG::Butler, string_compose ("butler refills %1, playback load = %2\n", tr->name(), tr->playback_buffer_load()));
+		switch (tr->do_refill ()) {
+			case 0:
+				//DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill done %1\n", tr->name()));
+				break;
+
+			case 1:
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", tr->name ()));
+				disk_work_outstanding = true;
+				break;
+
+			default:
+				error << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << endmsg;
+				std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), (*i)->name ()) << std::endl;
+				break;
+		}
+	}
+
+	if (i != rl.begin () && i != rl.end ()) {
+		/* we didn't get to all the streams */
+		disk_work_outstanding = true;
+	}
+
+	return disk_work_outstanding;
+}
+
 bool
 Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32_t& errors)
 {
@@ -379,6 +467,137 @@ Butler::flush_tracks_to_disk_normal (std::shared_ptr<RouteList const> rl, uint32
 	return disk_work_outstanding;
 }
 
+/** Flush and refill all tracks using the butler thread and the worker
+ * pool. Capture flushes are handed out first, then playback refills, each
+ * ordered so that the tracks closest to an over- or underrun go first.
+ */
+bool
+Butler::flush_and_refill_tracks_parallel (std::shared_ptr<RouteList const> rl, RouteList const& rl_with_auditioner, uint32_t& errors)
+{
+	std::vector<DiskJob> jobs;
+
+	for (auto const& r : *rl) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+		if (!tr) {
+			continue;
+		}
+		/* note that we still try to flush diskstreams attached to inactive routes */
+		jobs.push_back (DiskJob (tr, true, tr->capture_buffer_load ()));
+	}
+
+	for (auto const& r : rl_with_auditioner) {
+		std::shared_ptr<Track> tr = std::dynamic_pointer_cast<Track> (r);
+		if (!tr) {
+			continue;
+		}
+		std::shared_ptr<IO> io = tr->input ();
+		if (io && !io->active ()) {
+			/* don't read inactive tracks */
+			continue;
+		}
+		jobs.push_back (DiskJob (tr, false, tr->playback_buffer_load ()));
+	}
+
+	std::stable_sort (jobs.begin (), jobs.end (), DiskJobSorter ());
+
+	DEBUG_TRACE (DEBUG::Butler, string_compose ("butler dispatches %1 disk jobs to %2 workers, twr = %3\n", jobs.size (), _workers.size (), transport_work_requested ()));
+
+	Glib::Threads::Mutex::Lock lm (_job_lock);
+
+	_jobs.swap (jobs);
+	_next_job         = 0;
+	_job_errors       = 0;
+	_jobs_outstanding = false;
+
+	_job_available.broadcast ();
+
+	process_disk_jobs (lm);
+
+	while (_jobs_active > 0) {
+		_jobs_done.wait (_job_lock);
+	}
+
+	/* do not hold on to track references until the next cycle */
+	_jobs.clear ();
+
+	errors += _job_errors;
+	return _jobs_outstanding;
+}
+
+/* called with _job_lock held */
+void
+Butler::process_disk_jobs (Glib::Threads::Mutex::Lock& lm)
+{
+	while (_next_job < _jobs.size ()) {
+		DiskJob job (_jobs[_next_job++]);
+
+		++_jobs_active;
+		lm.release ();
+
+		int ret = run_disk_job (job);
+
+		lm.acquire ();
+
+		if (ret > 0) {
+			_jobs_outstanding = true;
+		} else if (ret < 0 && job.flush) {
+			++_job_errors;
+		}
+
+		if (--_jobs_active == 0 && _next_job >= _jobs.size ()) {
+			_jobs_done.signal ();
+		}
+	}
+}
+
+int
+Butler::run_disk_job (DiskJob const& job)
+{
+	if (transport_work_requested () || !should_run) {
+		/* leave it for the next pass, after transport work is done */
+		return 1;
+	}
+
+	Temporal::TempoMap::fetch ();
+
+	int ret;
+
+	if (job.flush) {
+		ret = job.track->do_flush (ButlerContext, false);
+		if (ret < 0) {
+			error << string_compose (_("Butler write-behind failure on dstream %1"), job.track->name ()) << endmsg;
+			std::cerr << string_compose (_("Butler write-behind failure on dstream %1"), job.track->name ()) << std::endl;
+		}
+	} else {
+		ret = job.track->do_refill ();
+		if (ret < 0) {
+			error << string_compose (_("Butler read ahead failure on dstream %1"), job.track->name ()) << endmsg;
+			std::cerr << string_compose (_("Butler read ahead failure on dstream %1"), job.track->name ()) << std::endl;
+		} else if (ret > 0) {
+			DEBUG_TRACE (DEBUG::Butler, string_compose ("\ttrack refill unfinished %1\n", job.track->name ()));
+		}
+	}
+
+	return ret;
+}
+
+void
+Butler::worker_thread_work ()
+{
+	SessionEvent::create_per_thread_pool (X_("butler worker events"), 64);
+	DiskReader::allocate_thread_working_buffers ();
+
+	Glib::Threads::Mutex::Lock lm (_job_lock);
+
+	while (_workers_run) {
+		if (_next_job >= _jobs.size ()) {
+			_job_available.wait (_job_lock);
+			continue;
+		}
+		process_disk_jobs (lm);
+	}
+}
+
 void
 Butler::schedule_transport_work ()
 {
@@ -410,9 +629,38 @@ void
 Butler::summon ()
 {
 	DEBUG_TRACE (DEBUG::Butler, string_compose ("%1: summon butler to run @ %2\n", DEBUG_THREAD_SELF, g_get_monotonic_time ()));
+
+	/* remember the first request, until the butler completes */
+	int64_t none = 0;
+	_summon_time.compare_exchange_strong (none, g_get_monotonic_time ());
+
 	queue_request (Request::Run);
 }
 
+bool
+Butler::refill_latency (int64_t& min, int64_t& max, double& avg, uint64_t& cnt) const
+{
+	Glib::Threads::Mutex::Lock ll (_latency_lock);
+	if (_latency_cnt == 0) {
+		return false;
+	}
+	min = _latency_min;
+	max = _latency_max;
+	avg = _latency_sum / _latency_cnt;
+	cnt = _latency_cnt;
+	return true;
+}
+
+void
+Butler::reset_refill_latency ()
+{
+	Glib::Threads::Mutex::Lock ll (_latency_lock);
+	_latency_min = std::numeric_limits<int64_t>::max ();
+	_latency_max = 0;
+	_latency_sum = 0;
+	_latency_cnt = 0;
+}
+
 void
 Butler::stop ()
 {
@@ -0,0 +1,155 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+
+#include "pbd/compose.h"
+#include "pbd/debug.h"
+
+#include "ardour/audiosource.h"
+#include "ardour/clip_sample_store.h"
+#include "ardour/debug.h"
+
+using namespace ARDOUR;
+
+ClipSampleStore::Buffer::Buffer (samplecnt_t length)
+	: _data (new Sample[length])
+	, _length (length)
+{
+}
+
+ClipSampleStore::Buffer::~Buffer ()
+{
+	delete [] _data;
+}
+
+ClipSampleStore&
+ClipSampleStore::instance ()
+{
+	static ClipSampleStore store;
+	return store;
+}
+
+ClipSampleStore::BufferPtr
+ClipSampleStore::get (std::shared_ptr<AudioSource> src, samplepos_t start, samplecnt_t length)
+{
+	if (!src || length <= 0) {
+		return BufferPtr ();
+	}
+
+	Key const key (src->id (), start, length);
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	Buffers::iterator i;
+
+	while ((i = _buffers.find (key)) != _buffers.end () && i->second.pending) {
+		/* being loaded by another thread */
+		_loaded.wait (_lock);
+	}
+
+	if (i != _buffers.end ()) {
+		BufferPtr buf = i->second.buffer.lock ();
+		if (buf) {
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("ClipSampleStore: share %1 @ %2 len %3\n", src->name (), start, length));
+			return buf;
+		}
+	}
+
+	/* drop entries of buffers that are no longer used */
+	for (Buffers::iterator b = _buffers.begin (); b != _buffers.end ();) {
+		if (!b->second.pending && b->second.buffer.expired ()) {
+			_buffers.erase (b++);
+		} else {
+			++b;
+		}
+	}
+
+	_buffers[key] = Entry ();
+
+	/* read without holding the lock, other clips can be loaded meanwhile */
+	lm.release ();
+
+	BufferPtr   buf;
+	samplecnt_t got;
+
+	try {
+		buf.reset (new Buffer (length));
+		got = src->read (buf->_data, start, length);
+	} catch (...) {
+		/* do not leave waiters behind */
+		lm.acquire ();
+		_buffers.erase (key);
+		_loaded.broadcast ();
+		throw;
+	}
+
+	if (got >= 0 && got < length) {
+		memset (buf->_data + got, 0, sizeof (Sample) * (length - got));
+	}
+
+	lm.acquire ();
+
+	if (got < 0) {
+		_buffers.erase (key);
+		_loaded.broadcast ();
+		return BufferPtr ();
+	}
+
+	Entry& e (_buffers[key]);
+	e.buffer  = buf;
+	e.pending = false;
+	_loaded.broadcast ();
+
+	DEBUG_TRACE (DEBUG::Triggers, string_compose ("ClipSampleStore: loaded %1 @ %2 len %3, %4 buffers using %5 bytes\n",
+	                                              src->name (), start, length, _buffers.size (), memory_footprint_locked ()));
+	return buf;
+}
+
+size_t
+ClipSampleStore::memory_footprint_locked () const
+{
+	size_t bytes = 0;
+	for (Buffers::const_iterator i = _buffers.begin (); i != _buffers.end (); ++i) {
+		BufferPtr buf = i->second.buffer.lock ();
+		if (buf) {
+			bytes += buf->length () * sizeof (Sample);
+		}
+	}
+	return bytes;
+}
+
+size_t
+ClipSampleStore::memory_footprint () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	return memory_footprint_locked ();
+}
+
+size_t
+ClipSampleStore::n_buffers () const
+{
+	Glib::Threads::Mutex::Lock lm (_lock);
+	size_t n = 0;
+	for (Buffers::const_iterator i = _buffers.begin (); i != _buffers.end (); ++i) {
+		if (!i->second.buffer.expired ()) {
+			++n;
+		}
+	}
+	return n;
+}
@@ -0,0 +1,234 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cstring>
+
+#include "ardour/audioregion.h"
+#include "ardour/audiosource.h"
+#include "ardour/clip_stream.h"
+
+using namespace ARDOUR;
+
+/* maximum number of samples per channel read at once by the worker */
+#define REFILL_CHUNK 65536
+
+ClipStream::ClipStream (std::shared_ptr<AudioRegion> r, samplecnt_t head, samplecnt_t bufsize)
+	: _region (r)
+	, _n_channels (r->n_channels ())
+	, _length (r->length_samples ())
+	, _head (head)
+	, _lookahead (bufsize / 16)
+	, _read_pos (-1)
+	, _dirty (false)
+	, _fill_pos (0)
+	, _seek_pos (0)
+	, _seek_id (0)
+	, _served_seek (0)
+	, _want_refill (false)
+	, _pending (false)
+	, _eof (false)
+	, _underruns (0)
+{
+	for (uint32_t chn = 0; chn < _n_channels; ++chn) {
+		_rb.push_back (new PBD::RingBuffer<Sample> (bufsize));
+	}
+
+	/* prime the buffer with the data following the head */
+	seek (_head);
+}
+
+ClipStream::~ClipStream ()
+{
+	for (auto const& rb : _rb) {
+		delete rb;
+	}
+}
+
+/* The channels advance in lock-step, but the worker commits
+ * one channel after the other, so only the common part is used.
+ */
+samplecnt_t
+ClipStream::read_space () const
+{
+	size_t rs = _rb.front ()->read_space ();
+	for (auto const& rb : _rb) {
+		rs = std::min (rs, rb->read_space ());
+	}
+	return rs;
+}
+
+samplecnt_t
+ClipStream::write_space () const
+{
+	size_t ws = _rb.front ()->write_space ();
+	for (auto const& rb : _rb) {
+		ws = std::min (ws, rb->write_space ());
+	}
+	return ws;
+}
+
+void
+ClipStream::silence (Sample* const* dst, samplecnt_t offset, samplecnt_t cnt) const
+{
+	for (uint32_t chn = 0; chn < _n_channels; ++chn) {
+		memset (dst[chn] + offset, 0, sizeof (Sample) * cnt);
+	}
+}
+
+void
+ClipStream::request_refill ()
+{
+	if (!_pending.exchange (true)) {
+		_want_refill.store (true);
+	}
+}
+
+void
+ClipStream::seek (samplepos_t pos)
+{
+	pos = std::max (pos, _head);
+
+	if (pos == _read_pos && !_dirty) {
+		/* nothing was consumed since the last seek */
+		return;
+	}
+
+	_read_pos = pos;
+	_dirty    = false;
+	_eof.store (false);
+	_seek_pos.store (pos);
+	_seek_id.store (_seek_id.load () + 1);
+
+	request_refill ();
+}
+
+samplecnt_t
+ClipStream::read (Sample* const* dst, samplecnt_t offset, samplepos_t pos, samplecnt_t cnt)
+{
+	if (pos > _read_pos || pos + cnt < _read_pos - _lookahead) {
+		/* not contiguous, restart a bit ahead, and play silence until then */
+		silence (dst, offset, cnt);
+		seek (pos + cnt + _lookahead);
+		return 0;
+	}
+
+	if (pos < _read_pos) {
+		/* still waiting for the position of the last seek */
+		samplecnt_t const skip = std::min (cnt, _read_pos - pos);
+		silence (dst, offset, skip);
+		offset += skip;
+		cnt    -= skip;
+		if (cnt == 0) {
+			return 0;
+		}
+	}
+
+	if (!ready ()) {
+		/* the worker did not yet refill the buffer */
+		_underruns.fetch_add (1);
+		silence (dst, offset, cnt);
+		seek (_read_pos + cnt + _lookahead);
+		return 0;
+	}
+
+	samplecnt_t const got = std::min (cnt, read_space ());
+
+	for (uint32_t chn = 0; chn < _n_channels; ++chn) {
+		_rb[chn]->read (dst[chn] + offset, got);
+	}
+
+	_dirty     = true;
+	_read_pos += got;
+
+	if (got < cnt) {
+		_underruns.fetch_add (1);
+		silence (dst, offset + got, cnt - got);
+		seek (_read_pos + (cnt - got) + _lookahead);
+		return got;
+	}
+
+	if (!_eof.load () && write_space () >= (samplecnt_t) _rb.front ()->bufsize () / 2) {
+		request_refill ();
+	}
+
+	return got;
+}
+
+void
+ClipStream::refill ()
+{
+	_pending.store (false);
+
+	uint32_t const id = _seek_id.load ();
+
+	if (id != _served_seek.load ()) {
+		/* The process thread does not read while a seek is pending,
+		 * so the buffer can be reset here.
+		 */
+		for (auto const& rb : _rb) {
+			rb->reset ();
+		}
+		_fill_pos = _seek_pos.load ();
+		_eof.store (false);
+	}
+
+	samplepos_t const start = _region->start_sample ();
+
+	while (_fill_pos < _length && _seek_id.load () == id) {
+		samplecnt_t n = std::min<samplecnt_t> (write_space (), _length - _fill_pos);
+		if (n == 0) {
+			break;
+		}
+		n = std::min<samplecnt_t> (n, REFILL_CHUNK);
+
+		for (uint32_t chn = 0; chn < _n_channels; ++chn) {
+			PBD::RingBuffer<Sample>::rw_vector vec;
+			_rb[chn]->get_write_vector (&vec);
+
+			std::shared_ptr<AudioSource> src = _region->audio_source (chn);
+
+			samplecnt_t const n0 = std::min<samplecnt_t> (n, vec.len[0]);
+			samplecnt_t       got = src->read (vec.buf[0], start + _fill_pos, n0);
+			if (got < n0) {
+				memset (vec.buf[0] + std::max<samplecnt_t> (0, got), 0, sizeof (Sample) * (n0 - std::max<samplecnt_t> (0, got)));
+			}
+			if (n > n0) {
+				got = src->read (vec.buf[1], start + _fill_pos + n0, n - n0);
+				if (got < n - n0) {
+					memset (vec.buf[1] + std::max<samplecnt_t> (0, got), 0, sizeof (Sample) * (n - n0 - std::max<samplecnt_t> (0, got)));
+				}
+			}
+
+			_rb[chn]->increment_write_idx (n);
+		}
+
+		_fill_pos += n;
+	}
+
+	if (_seek_id.load () != id) {
+		/* seek while filling, the next refill starts over */
+		return;
+	}
+
+	if (_fill_pos >= _length) {
+		_eof.store (true);
+	}
+
+	_served_seek.store (id);
+}
@@ -57,6 +57,32 @@ DiskReader::Declicker DiskReader::loop_declick_in;
 DiskReader::Declicker DiskReader::loop_declick_out;
 samplecnt_t           DiskReader::loop_fade_length (0);
 
+namespace {
+
+struct ThreadWorkingBuffers {
+	/* see DiskReader::allocate_working_buffers() for the size */
+	ThreadWorkingBuffers ()
+		: sum_buffer (new Sample[2 * 1048576])
+		, mixdown_buffer (new Sample[2 * 1048576])
+		, gain_buffer (new gain_t[2 * 1048576])
+	{}
+
+	~ThreadWorkingBuffers ()
+	{
+		delete[] sum_buffer;
+		delete[] mixdown_buffer;
+		delete[] gain_buffer;
+	}
+
+	Sample* sum_buffer;
+	Sample* mixdown_buffer;
+	gain_t* gain_buffer;
+};
+
+Glib::Threads::Private<ThreadWorkingBuffers> thread_working_buffers;
+
+}
+
 DiskReader::DiskReader (Session& s, Track& t, string const& str, Temporal::TimeDomainProvider const & tdp, DiskIOProcessor::Flag f)
 	: DiskIOProcessor (s, t, X_("player:") + str, f, tdp)
 	, overwrite_sample (0)
@@ -137,6 +163,14 @@ DiskReader::allocate_working_buffers ()
 	_gain_buffer    = new gain_t[2 * 1048576];
 }
 
+void
+DiskReader::allocate_thread_working_buffers ()
+{
+	if (!thread_working_buffers.get ()) {
+		thread_working_buffers.set (new ThreadWorkingBuffers);
+	}
+}
+
 void
 DiskReader::free_working_buffers ()
 {
@@ -1111,6 +1145,12 @@ int
 DiskReader::do_refill ()
 {
 	const bool reversed = !_session.transport_will_roll_forwards ();
+
+	ThreadWorkingBuffers* twb = thread_working_buffers.get ();
+	if (twb) {
+		return refill (twb->sum_buffer, twb->mixdown_buffer, twb->gain_buffer, 0, reversed);
+	}
+
 	return refill (_sum_buffer, _mixdown_buffer, _gain_buffer, 0, reversed);
 }
 
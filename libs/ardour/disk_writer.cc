@@ -100,10 +100,22 @@ DiskWriter::WriterChannelInfo::resize (samplecnt_t bufsize)
 	if (!capture_transition_buf) {
 		capture_transition_buf = new RingBufferNPT<CaptureTransition> (256);
 	}
-	delete wbuf;
-	wbuf = new RingBufferNPT<Sample> (bufsize);
-	/* touch memory to lock it */
-	memset (wbuf->buffer(), 0, sizeof (Sample) * wbuf->bufsize());
+}
+
+void
+DiskWriter::alloc_capture_buffer (uint32_t n_chan)
+{
+	std::shared_ptr<PBD::MultiChannelRingBuffer<Sample> > cb;
+
+	if (n_chan > 0) {
+		cb.reset (new PBD::MultiChannelRingBuffer<Sample> (n_chan, _session.butler()->audio_capture_buffer_size()));
+		/* touch memory to lock it */
+		for (uint32_t n = 0; n < n_chan; ++n) {
+			memset (cb->buffer (n), 0, sizeof (Sample) * cb->bufsize());
+		}
+	}
+
+	std::atomic_store (&_capture_buf, cb);
 }
 
 int
@@ -111,10 +123,7 @@ DiskWriter::add_channel_to (std::shared_ptr<ChannelList> c, uint32_t how_many)
 {
 	while (how_many--) {
 		c->push_back (new WriterChannelInfo (_session.butler()->audio_capture_buffer_size()));
-		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: new writer channel, write space = %2 read = %3\n",
-		                                            name(),
-		                                            c->back()->wbuf->write_space(),
-		                                            c->back()->wbuf->read_space()));
+		DEBUG_TRACE (DEBUG::DiskIO, string_compose ("%1: new writer channel\n", name()));
 	}
 
 	return 0;
@@ -520,15 +529,11 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 					_capture_captured  -= _playback_offset + _capture_offset;
 				}
 
-				if (_capture_captured > 0) {
+				if (_capture_captured > 0 && _capture_buf) {
 					/* when enabling record while already looping,
 					 * zero fill region back to loop-start.
 					 */
-					for (auto const& chaninfo : *c) {
-						for (samplecnt_t s = 0; s < _capture_captured; ++s) {
-							chaninfo->wbuf->write_one (0); // TODO: optimize
-						}
-					}
+					_capture_buf->write_zero (_capture_captured);
 				}
 			}
 
@@ -571,42 +576,41 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 
 		/* AUDIO */
 
-		const size_t n_buffers = bufs.count().n_audio();
-		uint32_t n = 0;
+		if (_capture_buf && !c->empty ()) {
 
-		for (auto const& chaninfo : *c) {
-			AudioBuffer& buf (bufs.get_audio (n%n_buffers));
-			++n;
+			PBD::MultiChannelRingBuffer<Sample>& cb (*_capture_buf);
 
-			chaninfo->wbuf->get_write_vector (&chaninfo->rw_vector);
+			if (rec_nframes > (samplecnt_t) cb.write_space ()) {
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 overrun in %2, rec_nframes = %3 total space = %4\n",
+				                                            DEBUG_THREAD_SELF, name(), rec_nframes, cb.write_space ()));
+				Overrun ();
+				_xruns.push_back (_capture_captured);
+				_xrun_flag = false;
+				return;
+			}
 
-			if (rec_nframes <= (samplecnt_t) chaninfo->rw_vector.len[0]) {
+			const size_t   n_buffers = bufs.count().n_audio();
+			const uint32_t n_chan    = std::min ((uint32_t) c->size (), cb.n_channels ());
 
-				Sample *incoming = buf.data (rec_offset);
-				memcpy (chaninfo->rw_vector.buf[0], incoming, sizeof (Sample) * rec_nframes);
+			PBD::MultiChannelRingBuffer<Sample>::rw_vector vec;
 
-			} else {
+			for (uint32_t n = 0; n < n_chan; ++n) {
+				AudioBuffer& buf (bufs.get_audio (n % n_buffers));
+				Sample*      incoming = buf.data (rec_offset);
 
-				samplecnt_t total = chaninfo->rw_vector.len[0] + chaninfo->rw_vector.len[1];
+				cb.get_write_vector (n, &vec);
 
-				if (rec_nframes > total) {
-					DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 overrun in %2, rec_nframes = %3 total space = %4\n",
-					                                            DEBUG_THREAD_SELF, name(), rec_nframes, total));
-					Overrun ();
-					_xruns.push_back (_capture_captured);
-					_xrun_flag = false;
-					return;
+				if (rec_nframes <= (samplecnt_t) vec.len[0]) {
+					memcpy (vec.buf[0], incoming, sizeof (Sample) * rec_nframes);
+				} else {
+					samplecnt_t first = vec.len[0];
+					memcpy (vec.buf[0], incoming, sizeof (Sample) * first);
+					memcpy (vec.buf[1], incoming + first, sizeof (Sample) * (rec_nframes - first));
 				}
-
-				Sample *incoming = buf.data (rec_offset);
-				samplecnt_t first = chaninfo->rw_vector.len[0];
-
-				memcpy (chaninfo->rw_vector.buf[0], incoming, sizeof (Sample) * first);
-				memcpy (chaninfo->rw_vector.buf[1], incoming + first, sizeof (Sample) * (rec_nframes - first));
 			}
 
-			chaninfo->wbuf->increment_write_ptr (rec_nframes);
-
+			/* publish all channels at once */
+			cb.increment_write_idx (rec_nframes);
 		}
 
 		/* MIDI */
@@ -737,8 +741,8 @@ DiskWriter::run (BufferSet& bufs, samplepos_t start_sample, samplepos_t end_samp
 
 	/* AUDIO BUTLER REQUIRED CODE */
 
-	if (_playlists[DataType::AUDIO] && !c->empty()) {
-		if (((samplecnt_t) c->front()->wbuf->read_space() >= _chunk_samples)) {
+	if (_playlists[DataType::AUDIO] && !c->empty() && _capture_buf) {
+		if (((samplecnt_t) _capture_buf->read_space() >= _chunk_samples)) {
 			_need_butler = true;
 		}
 	}
@@ -894,14 +898,14 @@ DiskWriter::prep_record_disable ()
 float
 DiskWriter::buffer_load () const
 {
-	std::shared_ptr<ChannelList const> c = channels.reader();
+	std::shared_ptr<PBD::MultiChannelRingBuffer<Sample> > cb = std::atomic_load (&_capture_buf);
 
-	if (c->empty ()) {
+	if (!cb) {
 		return 1.0;
 	}
 
-	return (float) ((double) c->front()->wbuf->write_space()/
-			(double) c->front()->wbuf->bufsize());
+	return (float) ((double) cb->write_space()/
+			(double) cb->bufsize());
 }
 
 void
@@ -932,12 +936,10 @@ DiskWriter::seek (samplepos_t /*sample*/, bool /*complete_refill*/)
 void
 DiskWriter::reset_capture ()
 {
-	uint32_t n;
-	ChannelList::const_iterator chan;
-	std::shared_ptr<ChannelList const> c = channels.reader();
+	std::shared_ptr<PBD::MultiChannelRingBuffer<Sample> > cb = std::atomic_load (&_capture_buf);
 
-	for (n = 0, chan = c->begin(); chan != c->end(); ++chan, ++n) {
-		(*chan)->wbuf->reset ();
+	if (cb) {
+		cb->reset ();
 	}
 
 	if (_midi_buf) {
@@ -953,18 +955,13 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 {
 	uint32_t to_write;
 	int32_t ret = 0;
-	RingBufferNPT<Sample>::rw_vector vector;
-	samplecnt_t total;
-
-	vector.buf[0] = 0;
-	vector.buf[1] = 0;
 
 	std::shared_ptr<ChannelList const> c = channels.reader();
-	for (auto const& chan : *c) {
+	std::shared_ptr<PBD::MultiChannelRingBuffer<Sample> > cb = std::atomic_load (&_capture_buf);
 
-		chan->wbuf->get_read_vector (&vector);
+	if (cb && !c->empty ()) {
 
-		total = vector.len[0] + vector.len[1];
+		const samplecnt_t total = cb->read_space ();
 
 		if (total == 0 || (total < _chunk_samples && !force_flush && _was_recording)) {
 			goto out;
@@ -985,35 +982,43 @@ DiskWriter::do_flush (RunContext ctxt, bool force_flush)
 			ret = 1;
 		}
 
-		to_write = min (_chunk_samples, (samplecnt_t) vector.len[0]);
-
-		if ((!chan->write_source) || chan->write_source->write (vector.buf[0], to_write) != to_write) {
-			error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
-			return -1;
-		}
+		/* all channels hold the same amount of data, write
+		 * one chunk of each and release them together.
+		 */
+		const samplecnt_t cnt    = min (_chunk_samples, total);
+		const uint32_t    n_chan = std::min ((uint32_t) c->size (), cb->n_channels ());
 
-		chan->wbuf->increment_read_ptr (to_write);
-		chan->curr_capture_cnt += to_write;
+		PBD::MultiChannelRingBuffer<Sample>::rw_vector vector;
 
-		if ((to_write == vector.len[0]) && (total > to_write) && (to_write < _chunk_samples)) {
+		for (uint32_t n = 0; n < n_chan; ++n) {
 
-			/* we wrote all of vector.len[0] but it wasn't an entire
-			   disk_write_chunk_samples of data, so arrange for some part
-			   of vector.len[1] to be flushed to disk as well.
-			*/
+			ChannelInfo* chan = (*c)[n];
 
-			to_write = min ((samplecnt_t)(_chunk_samples - to_write), (samplecnt_t) vector.len[1]);
+			cb->get_read_vector (n, &vector);
 
-                        DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), to_write));
+			const samplecnt_t first = min (cnt, (samplecnt_t) vector.len[0]);
 
-			if (chan->write_source->write (vector.buf[1], to_write) != to_write) {
+			if ((!chan->write_source) || chan->write_source->write (vector.buf[0], first) != first) {
 				error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
 				return -1;
 			}
 
-			chan->wbuf->increment_read_ptr (to_write);
-			chan->curr_capture_cnt += to_write;
+			if (first < cnt) {
+
+				/* the chunk wraps around the end of the buffer */
+
+				DEBUG_TRACE (DEBUG::Butler, string_compose ("%1 additional write of %2\n", name(), cnt - first));
+
+				if (chan->write_source->write (vector.buf[1], cnt - first) != cnt - first) {
+					error << string_compose(_("AudioDiskstream %1: cannot write to disk"), id()) << endmsg;
+					return -1;
+				}
+			}
+
+			chan->curr_capture_cnt += cnt;
 		}
+
+		cb->increment_read_idx (cnt);
 	}
 
 	/* MIDI*/
@@ -1383,6 +1388,8 @@ DiskWriter::adjust_buffering ()
 	for (auto const chan : *c) {
 		chan->resize (_session.butler()->audio_capture_buffer_size());
 	}
+
+	alloc_capture_buffer (c->size ());
 }
 
 void
@@ -1451,6 +1458,13 @@ DiskWriter::configure_io (ChanCount in, ChanCount out)
 		return false;
 	}
 
+	{
+		std::shared_ptr<ChannelList const> c = channels.reader();
+		if (!_capture_buf || _capture_buf->n_channels () != c->size ()) {
+			alloc_capture_buffer (c->size ());
+		}
+	}
+
 	if (record_enabled() || changed) {
 		reset_write_sources (false, true);
 	}
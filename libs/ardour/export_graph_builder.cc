@@ -115,7 +115,7 @@ using std::string;
  * |     Peak Reader -> Loudness Reader -> TMP File       |
  * |                                         |            |
  * |                                         v            |
- * |               Threader (run SFC childs in parallel)  |
+ * |    Threader (run SFC childs in parallel, pipelined)  |
  * }                                         |            |
  *                                           v            |
  *      /------------------------------------/            |
@@ -155,9 +155,9 @@ using std::string;
 
 namespace ARDOUR {
 
-ExportGraphBuilder::ExportGraphBuilder (Session const & session)
+ExportGraphBuilder::ExportGraphBuilder (Session const & session, std::shared_ptr<WorkerPool> pool)
 	: session (session)
-	, thread_pool (hardware_concurrency())
+	, _worker_pool (pool ? pool : std::shared_ptr<WorkerPool> (new WorkerPool (hardware_concurrency())))
 {
 	process_buffer_samples = session.engine().samples_per_cycle();
 }
@@ -203,6 +203,54 @@ ExportGraphBuilder::process (samplecnt_t samples, bool last_cycle)
 	return samples - off;
 }
 
+void
+ExportGraphBuilder::read_channels (ChannelBuffers& bufs, samplecnt_t samples)
+{
+	assert(samples <= process_buffer_samples);
+
+	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
+		if (bufs.find (it->first) != bufs.end ()) {
+			continue;
+		}
+		Buffer const* buf;
+		it->first->read (buf, samples);
+		bufs[it->first] = buf;
+	}
+}
+
+sampleoffset_t
+ExportGraphBuilder::process_offset (samplecnt_t samples) const
+{
+	if (session.remaining_latency_preroll () >= _master_align + samples) {
+		return -1;
+	}
+	if (session.remaining_latency_preroll () > _master_align) {
+		return session.remaining_latency_preroll () - _master_align;
+	}
+	return 0;
+}
+
+void
+ExportGraphBuilder::process (ChannelBuffers const& bufs, sampleoffset_t off, samplecnt_t samples, bool last_cycle)
+{
+	for (ChannelMap::iterator it = channels.begin(); it != channels.end(); ++it) {
+		ChannelBuffers::const_iterator b = bufs.find (it->first);
+		assert (b != bufs.end ());
+
+		AudioBuffer const* ab = dynamic_cast<AudioBuffer const*> (b->second);
+		MidiBuffer const*  mb;
+		if (ab) {
+			Sample const* process_buffer = ab->data ();
+			ConstProcessContext<Sample> context(&process_buffer[off], samples, 1);
+			if (last_cycle) { context().set_flag (ProcessContext<Sample>::EndOfInput); }
+			it->second->process (context);
+		}
+		if  ((mb = dynamic_cast<MidiBuffer const*> (b->second))) {
+			it->second->process (*mb, off, samples, last_cycle);
+		}
+	}
+}
+
 bool
 ExportGraphBuilder::post_process ()
 {
@@ -238,6 +286,8 @@ ExportGraphBuilder::reset ()
 	_exported_files.clear();
 	_realtime = false;
 	_master_align = 0;
+	/* the engine's buffer-size may change for an export */
+	process_buffer_samples = session.engine().samples_per_cycle();
 }
 
 void
@@ -791,7 +841,7 @@ ExportGraphBuilder::Intermediate::Intermediate (ExportGraphBuilder & parent, Fil
 
 	peak_reader.reset (new PeakReader ());
 	loudness_reader.reset (new LoudnessReader (config.format->sample_rate(), channels, max_samples));
-	threader.reset (new Threader<Sample> (parent.thread_pool));
+	threader.reset (new Threader<Sample> (*parent._worker_pool));
 
 	int format = ExportFormatBase::F_RAW | ExportFormatBase::SF_Float;
 
@@ -22,6 +22,9 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
+#include <set>
+
 #include "pbd/gstdio_compat.h"
 #include <glibmm.h>
 #include <glibmm/convert.h>
@@ -39,6 +42,7 @@
 #include "ardour/export_status.h"
 #include "ardour/export_format_specification.h"
 #include "ardour/export_filename.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/soundcloud_upload.h"
 #include "ardour/surround_return.h"
 #include "ardour/system_exec.h"
@@ -128,6 +132,9 @@ ExportHandler::~ExportHandler ()
 		session.surround_master ()->surround_return ()->finalize_export ();
 	}
 	graph_builder->cleanup (export_status->aborted () );
+	for (auto const& b : batch) {
+		b.graph_builder->cleanup (export_status->aborted ());
+	}
 }
 
 /** Add an export to the `to-do' list */
@@ -165,10 +172,30 @@ ExportHandler::do_export ()
 		}
 	}
 
+	/* Freewheel exports are not bound to the hardware period,
+	 * process larger blocks to reduce per-cycle overhead.
+	 * Region exports allocate their buffers when the channel is created.
+	 */
+
+	bool large_blocks = Config->get_export_block_size () > 0;
+	for (ConfigMap::iterator it = config_map.begin(); it != config_map.end() && large_blocks; ++it) {
+		if (it->first->realtime () || it->second.channel_config->region_processing_type () != RegionExportChannelFactory::None) {
+			large_blocks = false;
+		}
+	}
+
+	if (large_blocks) {
+		session.set_export_block_size (Config->get_export_block_size ());
+	}
+
 	/* Start export */
 
 	Glib::Threads::Mutex::Lock l (export_status->lock());
-	return start_timespan ();
+	int rv = start_timespan ();
+	if (rv != 0) {
+		session.set_export_block_size (0);
+	}
+	return rv;
 }
 
 int
@@ -189,6 +216,12 @@ ExportHandler::start_timespan ()
 		return -1;
 	}
 
+	std::vector<ExportTimespanPtr> spans;
+	collect_batch (spans);
+	if (spans.size () > 1) {
+		return start_batch (spans);
+	}
+
 	export_status->timespan++;
 
 	/* finish_timespan pops the config_map entry that has been done, so
@@ -240,6 +273,127 @@ ExportHandler::start_timespan ()
 	return session.start_audio_export (process_position, realtime, region_export);
 }
 
+struct TimespanSortByStart {
+	bool operator() (ExportTimespanPtr const& a, ExportTimespanPtr const& b) {
+		return a->get_start () < b->get_start ();
+	}
+};
+
+/** Find timespans that can be exported together with the next timespan.
+ *
+ * Timespans are rendered in a single pass if they use the same
+ * channel configurations, and the time saved by not rendering
+ * overlapping parts twice, and by skipping pre-roll of a separate
+ * pass, outweighs rendering gaps between them.
+ */
+void
+ExportHandler::collect_batch (std::vector<ExportTimespanPtr>& rv)
+{
+	rv.clear ();
+
+	if (!Config->get_export_batch_timespans ()) {
+		return;
+	}
+
+	typedef std::set<ExportChannelConfigPtr> ChannelConfigs;
+	std::map<ExportTimespanPtr, ChannelConfigs> spans;
+
+	for (ConfigMap::iterator it = config_map.begin(); it != config_map.end(); ++it) {
+		ExportTimespanPtr ts = it->first;
+		if (ts->realtime () || !ts->vapor ().empty () || it->second.channel_config->region_processing_type () != RegionExportChannelFactory::None) {
+			return;
+		}
+		spans[ts].insert (it->second.channel_config);
+	}
+
+	ExportTimespanPtr const next     = config_map.begin()->first;
+	ChannelConfigs const&   channels = spans[next];
+
+	std::vector<ExportTimespanPtr> candidates;
+	for (auto const& i : spans) {
+		if (i.second == channels) {
+			candidates.push_back (i.first);
+		}
+	}
+
+	std::sort (candidates.begin (), candidates.end (), TimespanSortByStart ());
+
+	samplecnt_t const pass_overhead = Config->get_export_preroll () * session.nominal_sample_rate ();
+
+	std::vector<ExportTimespanPtr> group;
+	samplepos_t                    group_end = 0;
+	samplecnt_t                    group_len = 0;
+
+	for (auto const& ts : candidates) {
+		if (!group.empty ()) {
+			samplepos_t const end = std::max (group_end, ts->get_end ());
+			if (end - group.front ()->get_start () <= group_len + ts->get_length () + pass_overhead) {
+				group.push_back (ts);
+				group_end  = end;
+				group_len += ts->get_length ();
+				continue;
+			}
+			if (std::find (group.begin (), group.end (), next) != group.end ()) {
+				break;
+			}
+			group.clear ();
+		}
+		group.push_back (ts);
+		group_end = ts->get_end ();
+		group_len = ts->get_length ();
+	}
+
+	if (std::find (group.begin (), group.end (), next) != group.end ()) {
+		rv.swap (group);
+	}
+}
+
+int
+ExportHandler::start_batch (std::vector<ExportTimespanPtr> const& spans)
+{
+	samplepos_t const start = spans.front ()->get_start ();
+	std::string       names;
+
+	batch_end = start;
+	for (auto const& ts : spans) {
+		batch_end = std::max (batch_end, ts->get_end ());
+		names += (names.empty () ? "" : ", ") + ts->name ();
+	}
+
+	export_status->timespan += spans.size ();
+	export_status->total_samples_current_timespan = batch_end - start;
+	export_status->timespan_name = names;
+	export_status->processed_samples_current_timespan = 0;
+
+	graph_builder->reset ();
+
+	for (auto const& ts : spans) {
+		std::shared_ptr<ExportGraphBuilder> gb (new ExportGraphBuilder (session, graph_builder->worker_pool ()));
+
+		current_timespan = ts;
+		timespan_bounds  = config_map.equal_range (current_timespan);
+
+		gb->set_current_timespan (current_timespan);
+		handle_duplicate_format_extensions();
+
+		for (ConfigMap::iterator it = timespan_bounds.first; it != timespan_bounds.second; ++it) {
+			FileSpec & spec = it->second;
+			spec.filename->set_timespan (it->first);
+			gb->add_config (spec, false);
+		}
+
+		batch.push_back (BatchedTimespan (current_timespan, gb));
+	}
+
+	/* start export */
+
+	post_processing = false;
+	session.ProcessExport.connect_same_thread (process_connection, boost::bind (&ExportHandler::process, this, _1));
+	process_position = start;
+
+	return session.start_audio_export (process_position, false, false);
+}
+
 void
 ExportHandler::handle_duplicate_format_extensions()
 {
@@ -290,6 +444,9 @@ ExportHandler::process (samplecnt_t samples)
 		}
 	} else if (samples > 0) {
 		Glib::Threads::Mutex::Lock l (export_status->lock());
+		if (!batch.empty ()) {
+			return process_batch (samples);
+		}
 		return process_timespan (samples);
 	}
 	return 0;
@@ -344,9 +501,98 @@ ExportHandler::process_timespan (samplecnt_t samples)
 	return 0;
 }
 
+int
+ExportHandler::process_batch (samplecnt_t samples)
+{
+	export_status->active_job = ExportStatus::Exporting;
+
+	if (process_position >= batch_end) {
+		/* export complete, post-roll to feed and flush latent plugins */
+		if (process_position + samples < batch_end + session.worst_latency_preroll ()) {
+			process_position += samples;
+			return 0;
+		}
+
+		export_status->stop = true;
+
+		/* Start post-processing/normalizing if necessary */
+		unsigned cycles = 0;
+		post_processing = false;
+		for (auto const& b : batch) {
+			if (b.graph_builder->need_postprocessing ()) {
+				post_processing = true;
+				cycles = std::max (cycles, b.graph_builder->get_postprocessing_cycle_count ());
+			}
+		}
+
+		if (post_processing) {
+			export_status->total_postprocessing_cycles = cycles;
+			export_status->current_postprocessing_cycle = 0;
+		} else {
+			finish_batch ();
+		}
+		return 1; /* trigger realtime_stop() */
+	}
+
+	samplecnt_t const samples_to_read = std::min (samples, batch_end - process_position);
+
+	/* every channel is read once, and shared by all timespans */
+	ExportGraphBuilder::ChannelBuffers bufs;
+	for (auto const& b : batch) {
+		b.graph_builder->read_channels (bufs, samples_to_read);
+	}
+
+	sampleoffset_t const off = batch.front ().graph_builder->process_offset (samples_to_read);
+	if (off < 0) {
+		/* Skip processing during pre-roll */
+		return 0;
+	}
+
+	samplepos_t const end = process_position + samples_to_read - off;
+
+	for (auto& b : batch) {
+		if (b.done) {
+			continue;
+		}
+
+		samplepos_t const s = std::max (process_position, b.timespan->get_start ());
+		samplepos_t const e = std::min (end, b.timespan->get_end ());
+
+		if (s >= e) {
+			continue;
+		}
+
+		b.done = e == b.timespan->get_end ();
+		b.graph_builder->process (bufs, off + s - process_position, e - s, b.done);
+		export_status->processed_samples += e - s;
+	}
+
+	export_status->processed_samples_current_timespan += end - process_position;
+	process_position = end;
+
+	return 0;
+}
+
 int
 ExportHandler::post_process ()
 {
+	if (!batch.empty ()) {
+		bool done = true;
+		for (auto const& b : batch) {
+			if (!b.graph_builder->post_process ()) {
+				done = false;
+			}
+		}
+		if (done) {
+			finish_batch ();
+			export_status->active_job = ExportStatus::Exporting;
+		} else {
+			export_status->active_job = ExportStatus::Normalizing;
+		}
+		export_status->current_postprocessing_cycle++;
+		return 0;
+	}
+
 	if (graph_builder->post_process ()) {
 		finish_timespan ();
 		export_status->active_job = ExportStatus::Exporting;
@@ -390,6 +636,40 @@ ExportHandler::finish_timespan ()
 		session.surround_master ()->surround_return ()->finalize_export ();
 	}
 
+	finish_timespan_configs ();
+
+	/* finish timespan is called in freewheeling rt-context,
+	 * we cannot start a new export from here */
+	assert (AudioEngine::instance()->freewheeling ());
+	pthread_t tid;
+	pthread_create (&tid, NULL, ExportHandler::start_timespan_bg, this);
+	pthread_detach (tid);
+}
+
+void
+ExportHandler::finish_batch ()
+{
+	std::shared_ptr<ExportGraphBuilder> gb (graph_builder);
+
+	for (auto const& b : batch) {
+		graph_builder    = b.graph_builder;
+		current_timespan = b.timespan;
+		timespan_bounds  = config_map.equal_range (current_timespan);
+		finish_timespan_configs ();
+	}
+
+	graph_builder = gb;
+	batch.clear ();
+
+	assert (AudioEngine::instance()->freewheeling ());
+	pthread_t tid;
+	pthread_create (&tid, NULL, ExportHandler::start_timespan_bg, this);
+	pthread_detach (tid);
+}
+
+void
+ExportHandler::finish_timespan_configs ()
+{
 	graph_builder->get_analysis_results (export_status->result_map);
 
 	/* work-around: split-channel will produce several files
@@ -397,23 +677,25 @@ ExportHandler::finish_timespan ()
 	 * take that into account.
 	 */
 	for (auto const& f : graph_builder->exported_files ()) {
-		Session::Exported (current_timespan->name(), f, config_map.begin()->second.format->reimport(), current_timespan->get_start ()); /* EMIT SIGNAL */
+		Session::Exported (current_timespan->name(), f, timespan_bounds.first->second.format->reimport(), current_timespan->get_start ()); /* EMIT SIGNAL */
 	}
 
-	while (config_map.begin() != timespan_bounds.second) {
+	while (timespan_bounds.first != timespan_bounds.second) {
 
 		// XXX single timespan+format may produce multiple files
 		// e.g export selection == session
 		// -> TagLib::FileRef is null
 
-		FileSpec& config = config_map.begin()->second;
+		FileSpec& config = timespan_bounds.first->second;
 		ExportFormatSpecPtr fmt = config.format;
+		// Filenames can be shared across timespans
+		config.filename->set_timespan (current_timespan);
 		config.filename->set_channel_config (config.channel_config);
 		std::string filename = config.filename->get_path (fmt);
 
 		if (fmt->type () == ExportFormatBase::T_None) {
 			graph_builder->reset ();
-			config_map.erase (config_map.begin());
+			config_map.erase (timespan_bounds.first++);
 			continue;
 		}
 
@@ -539,15 +821,8 @@ ExportHandler::finish_timespan ()
 			}
 			delete soundcloud_uploader;
 		}
-		config_map.erase (config_map.begin());
+		config_map.erase (timespan_bounds.first++);
 	}
-
-	/* finish timespan is called in freewheeling rt-context,
-	 * we cannot start a new export from here */
-	assert (AudioEngine::instance()->freewheeling ());
-	pthread_t tid;
-	pthread_create (&tid, NULL, ExportHandler::start_timespan_bg, this);
-	pthread_detach (tid);
 }
 
 void
@@ -555,6 +830,7 @@ ExportHandler::reset ()
 {
 	config_map.clear ();
 	graph_builder->reset ();
+	batch.clear ();
 }
 
 /*** CD Marker stuff ***/
@@ -68,6 +68,10 @@ ExportSMFWriter::process (MidiBuffer const& buf, sampleoffset_t off, samplecnt_t
 		if (ev.time () < off) {
 			continue;
 		}
+		if (ev.time () >= off + n_samples) {
+			/* batched timespan export, the range ends in this cycle */
+			break;
+		}
 
 		samplepos_t pos = _pos + ev.time () - off;
 		assert (pos >= _last_ev_time_samples);
@@ -155,6 +155,9 @@ mix_buffers_with_gain_t ARDOUR::mix_buffers_with_gain = 0;
 mix_buffers_no_gain_t   ARDOUR::mix_buffers_no_gain   = 0;
 copy_vector_t           ARDOUR::copy_vector           = 0;
 
+apply_gain_ramp_to_buffer_t   ARDOUR::apply_gain_ramp_to_buffer   = 0;
+apply_gain_vector_to_buffer_t ARDOUR::apply_gain_vector_to_buffer = 0;
+
 PBD::Signal1<void, std::string>                    ARDOUR::BootMessage;
 PBD::Signal3<void, std::string, std::string, bool> ARDOUR::PluginScanMessage;
 PBD::Signal1<void, int>                            ARDOUR::PluginScanTimeout;
@@ -206,6 +209,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_avx512f_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 			copy_vector           = x86_avx512f_copy_vector;
+			apply_gain_ramp_to_buffer   = x86_avx512f_apply_gain_ramp_to_buffer;
+			apply_gain_vector_to_buffer = x86_avx512f_apply_gain_vector_to_buffer;
 
 			generic_mix_functions = false;
 
@@ -223,6 +228,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_fma_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			apply_gain_ramp_to_buffer   = x86_sse_avx_apply_gain_ramp_to_buffer;
+			apply_gain_vector_to_buffer = x86_sse_avx_apply_gain_vector_to_buffer;
 
 			generic_mix_functions = false;
 
@@ -238,6 +245,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_avx_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 			copy_vector           = x86_sse_avx_copy_vector;
+			apply_gain_ramp_to_buffer   = x86_sse_avx_apply_gain_ramp_to_buffer;
+			apply_gain_vector_to_buffer = x86_sse_avx_apply_gain_vector_to_buffer;
 
 			generic_mix_functions = false;
 
@@ -251,6 +260,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = x86_sse_mix_buffers_with_gain;
 			mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			apply_gain_ramp_to_buffer   = x86_sse_apply_gain_ramp_to_buffer;
+			apply_gain_vector_to_buffer = x86_sse_apply_gain_vector_to_buffer;
 
 			generic_mix_functions = false;
 		}
@@ -266,6 +277,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = arm_neon_mix_buffers_with_gain;
 			mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 			copy_vector           = arm_neon_copy_vector;
+			apply_gain_ramp_to_buffer   = arm_neon_apply_gain_ramp_to_buffer;
+			apply_gain_vector_to_buffer = arm_neon_apply_gain_vector_to_buffer;
 
 			generic_mix_functions = false;
 		}
@@ -279,6 +292,8 @@ setup_hardware_optimization (bool try_optimization)
 			mix_buffers_with_gain = veclib_mix_buffers_with_gain;
 			mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 			copy_vector           = default_copy_vector;
+			apply_gain_ramp_to_buffer   = default_apply_gain_ramp_to_buffer;
+			apply_gain_vector_to_buffer = veclib_apply_gain_vector_to_buffer;
 
 			generic_mix_functions = false;
 
@@ -298,6 +313,8 @@ setup_hardware_optimization (bool try_optimization)
 		mix_buffers_with_gain = default_mix_buffers_with_gain;
 		mix_buffers_no_gain   = default_mix_buffers_no_gain;
 		copy_vector           = default_copy_vector;
+		apply_gain_ramp_to_buffer   = default_apply_gain_ramp_to_buffer;
+		apply_gain_vector_to_buffer = default_apply_gain_vector_to_buffer;
 
 		info << "No H/W specific optimizations in use" << endmsg;
 	}
@@ -20,11 +20,15 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <algorithm>
 #include <cmath>
 #include <stdio.h>
 
+#include <glibmm/threads.h>
+
 #include "pbd/compose.h"
 #include "pbd/debug_rt_alloc.h"
+#include "pbd/microseconds.h"
 #include "pbd/pthread_utils.h"
 
 #include "temporal/superclock.h"
@@ -35,6 +39,7 @@
 #include "ardour/graph.h"
 #include "ardour/io_plug.h"
 #include "ardour/process_thread.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/route.h"
 #include "ardour/rt_task.h"
 #include "ardour/rt_tasklist.h"
@@ -47,6 +52,9 @@ using namespace ARDOUR;
 using namespace PBD;
 using namespace std;
 
+/* index of the calling graph thread, 0: main thread */
+static thread_local uint32_t graph_thread_id = 0;
+
 #ifdef DEBUG_RT_ALLOC
 static Graph* graph = 0;
 
@@ -73,6 +81,7 @@ Graph::Graph (Session& session)
 	_n_workers.store (0);
 	_idle_thread_cnt.store (0);
 	_trigger_queue_size.store (0);
+	_work_stealing = false;
 
 	/* pre-allocate memory */
 	_trigger_queue.reserve (1024);
@@ -124,6 +133,11 @@ Graph::reset_thread_list ()
 	/* Allow threads to run */
 	_terminate.store (0);
 
+	_thread_queues.clear ();
+	for (uint32_t i = 0; i < num_threads; ++i) {
+		_thread_queues.push_back (std::unique_ptr<ThreadQueue> (new ThreadQueue (1024)));
+	}
+
 	if (AudioEngine::instance ()->create_process_thread (boost::bind (&Graph::main_thread, this)) != 0) {
 		throw failed_constructor ();
 	}
@@ -153,6 +167,9 @@ Graph::session_going_away ()
 	/* now drop all references on the nodes. */
 	_trigger_queue_size.store (0);
 	_trigger_queue.clear ();
+	for (auto const& q : _thread_queues) {
+		q->clear ();
+	}
 	_graph_chain = 0;
 }
 
@@ -218,8 +235,21 @@ Graph::prep ()
 		_trigger_queue.reserve (_graph_chain->_nodes_rt.size ());
 	}
 
+	/* The scheduler can be changed at runtime, all threads are idle here */
+	_work_stealing = Config->get_graph_work_stealing () && _thread_queues.size () == n_threads ();
+
+	if (_work_stealing) {
+		for (auto const& q : _thread_queues) {
+			if (q->capacity () < _graph_chain->_nodes_rt.size ()) {
+				q->reserve (_graph_chain->_nodes_rt.size ());
+			}
+		}
+	}
+
 	_terminal_refcnt.store (_graph_chain->_n_terminal_nodes);
 
+	_graph_chain->update_priorities ();
+
 	/* Trigger the initial nodes for processing, which are the ones at the `input' end */
 	for (auto const& i : _graph_chain->_init_trigger_list) {
 		_trigger_queue_size.fetch_add (1);
@@ -231,9 +261,53 @@ void
 Graph::trigger (ProcessNode* n)
 {
 	_trigger_queue_size.fetch_add (1);
+
+	if (_work_stealing) {
+		assert (graph_thread_id < _thread_queues.size ());
+		/* Keep the node on the thread that processed its inputs,
+		 * the data is likely still in this core's cache.
+		 */
+		if (_thread_queues[graph_thread_id]->push_back (n)) {
+			return;
+		}
+	}
+
 	_trigger_queue.push_back (n);
 }
 
+/** Find a node to process. With the shared queue this is a plain pop;
+ * the work-stealing scheduler prefers the most recently triggered node
+ * of the calling thread, then initial nodes, and only then takes the
+ * oldest node from other threads.
+ */
+bool
+Graph::pop_work (ProcessNode*& to_run)
+{
+	if (!_work_stealing) {
+		return _trigger_queue.pop_front (to_run);
+	}
+
+	uint32_t const self = graph_thread_id;
+	uint32_t const n    = _thread_queues.size ();
+
+	if (_thread_queues[self]->pop_back (to_run)) {
+		return true;
+	}
+
+	if (_trigger_queue.pop_front (to_run)) {
+		return true;
+	}
+
+	/* start with the next thread, so that thieves spread out */
+	for (uint32_t i = 1; i < n; ++i) {
+		if (_thread_queues[(self + i) % n]->steal (to_run)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
 /** Called when a node at the `output' end of the chain (ie one that has no-one to feed)
  *  is finished.
  */
@@ -295,7 +369,7 @@ Graph::run_one ()
 		return;
 	}
 
-	if (_trigger_queue.pop_front (to_run)) {
+	if (pop_work (to_run)) {
 		/* Wake up idle threads, but at most as many as there's
 		 * work in the trigger queue that can be processed by
 		 * other threads.
@@ -311,6 +385,13 @@ Graph::run_one ()
 		}
 	}
 
+	/* Stealing can fail when racing with other threads. As long as
+	 * there is work, retry a few times rather than going to sleep.
+	 */
+	for (int spin = 0; !to_run && _work_stealing && spin < 8 && _trigger_queue_size.load () > 0; ++spin) {
+		pop_work (to_run);
+	}
+
 	while (!to_run) {
 		/* Wait for work, fall asleep */
 		_idle_thread_cnt.fetch_add (1);
@@ -328,7 +409,7 @@ Graph::run_one ()
 		PBD::atomic_dec_and_test (_idle_thread_cnt);
 
 		/* Try to find some work to do */
-		_trigger_queue.pop_front (to_run);
+		pop_work (to_run);
 	}
 
 	/* Update the thread-local tempo map ptr.
@@ -349,8 +430,9 @@ Graph::run_one ()
 void
 Graph::helper_thread ()
 {
-	_n_workers.fetch_add (1);
-	uint32_t id = _n_workers.load();
+	uint32_t id = _n_workers.fetch_add (1) + 1;
+
+	graph_thread_id = id;
 
 	/* This is needed for ARDOUR::Session requests called from rt-processors
 	 * in particular Lua scripts may do cross-thread calls */
@@ -382,6 +464,8 @@ Graph::main_thread ()
 {
 	/* first time setup */
 
+	graph_thread_id = 0;
+
 	suspend_rt_malloc_checks ();
 	ProcessThread* pt = new ProcessThread ();
 
@@ -601,8 +685,17 @@ Graph::process_tasklist (RTTaskList const& rt)
 
 /* ****************************************************************************/
 
+/* Activation sets of all chains are kept in one map per node. New and
+ * deleted chains copy these maps, while update_priorities() re-orders the
+ * lists of a chain in place.
+ */
+static Glib::Threads::Mutex activation_lock;
+
 GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
+	: _next_update (0)
 {
+	Glib::Threads::Mutex::Lock lm (activation_lock);
+
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphChain constructed in thread:%1\n", pthread_name ()));
 	/* This will become the number of nodes that do not feed any other node;
 	 * once we have processed this number of those nodes, we have finished.
@@ -633,11 +726,11 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 			std::shared_ptr<GraphActivision::ActivationMap const> m (ni->_activation_set.reader ());
 			for (auto const& i : fed_from_r) {
 				auto mm = const_cast<GraphActivision::ActivationMap*> (&(*m));
-				auto it = (*mm)[this].insert (i);
-				assert (it.second);
+				assert (std::find ((*mm)[this].begin (), (*mm)[this].end (), i) == (*mm)[this].end ());
+				(*mm)[this].push_back (i);
 
 				/* Increment the refcount of any node that we directly feed */
-				std::shared_ptr<GraphActivision::RefCntMap const> a ((*it.first)->_init_refcount.reader ());
+				std::shared_ptr<GraphActivision::RefCntMap const> a (i->_init_refcount.reader ());
 				auto aa = const_cast<GraphActivision::RefCntMap*> (&(*a));
 				(*aa)[this] += 1;
 			}
@@ -658,11 +751,109 @@ GraphChain::GraphChain (GraphNodeList const& nodelist, GraphEdges const& edges)
 			_n_terminal_nodes += 1;
 		}
 	}
+
+	prioritize ();
 	dump ();
 }
 
+/** Queue nodes on the critical path first.
+ *
+ * Nodes that become ready at the same time are processed in the order
+ * they are queued. Ordering the initial trigger list and each activation
+ * set by the cost of the longest remaining path lets expensive chains
+ * start early, instead of stretching the end of the cycle.
+ *
+ * Costs are the measured processing times of the nodes. When a
+ * session is loaded, nodes have not run yet and the order only
+ * depends on the length of paths, so update_priorities() refreshes
+ * it while the graph runs.
+ */
+void
+GraphChain::prioritize ()
+{
+	_downstream_first.reserve (_nodes_rt.size ());
+
+	for (auto const& ni : _nodes_rt) {
+		critical_path (ni);
+	}
+
+	sort_by_priority ();
+}
+
+void
+GraphChain::update_priorities ()
+{
+	int64_t const now = PBD::get_microseconds ();
+	if (now < _next_update) {
+		return;
+	}
+	_next_update = now + 1000000;
+
+	Glib::Threads::Mutex::Lock lm (activation_lock, Glib::Threads::TRY_LOCK);
+	if (!lm.locked ()) {
+		/* a chain is being created or destroyed, try again next cycle */
+		_next_update = 0;
+		return;
+	}
+
+	/* every node follows all nodes it feeds, so the critical path of
+	 * downstream nodes is already up to date.
+	 */
+	for (auto const& n : _downstream_first) {
+		double downstream = 0;
+		for (auto const& ai : n->activation_set (this)) {
+			downstream = std::max (downstream, _critical_path.at (ai.get ()));
+		}
+		_critical_path.at (n) = std::max (1.f, n->process_time ()) + downstream;
+	}
+
+	sort_by_priority ();
+}
+
+void
+GraphChain::sort_by_priority ()
+{
+	/* std::list::sort () re-links the nodes, it does not allocate */
+	auto by_priority = [this] (node_ptr_t const& a, node_ptr_t const& b) {
+		return _critical_path.at (a.get ()) > _critical_path.at (b.get ());
+	};
+
+	_init_trigger_list.sort (by_priority);
+
+	for (auto const& ni : _nodes_rt) {
+		std::shared_ptr<GraphActivision::ActivationMap const> m (ni->_activation_set.reader ());
+		auto mm = const_cast<GraphActivision::ActivationMap*> (&(*m));
+		(*mm)[this].sort (by_priority);
+	}
+}
+
+double
+GraphChain::critical_path (node_ptr_t const& n)
+{
+	auto it = _critical_path.find (n.get ());
+	if (it != _critical_path.end ()) {
+		return it->second;
+	}
+
+	double downstream = 0;
+	for (auto const& ai : n->activation_set (this)) {
+		downstream = std::max (downstream, critical_path (ai));
+	}
+
+	/* nodes without timing data yet still count, so that the
+	 * length of a path matters as well.
+	 */
+	double const cp = std::max (1.f, n->process_time ()) + downstream;
+
+	_critical_path[n.get ()] = cp;
+	_downstream_first.push_back (n.get ());
+	return cp;
+}
+
 GraphChain::~GraphChain ()
 {
+	Glib::Threads::Mutex::Lock lm (activation_lock);
+
 	/* clear chain */
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("~GraphChain destroyed in thread:%1\n", pthread_name ()));
 	for (auto const& ni : _nodes_rt) {
@@ -678,6 +869,8 @@ GraphChain::~GraphChain ()
 bool
 GraphChain::plot (std::string const& file_name) const
 {
+	Glib::Threads::Mutex::Lock lm (activation_lock);
+
 	node_list_t::const_iterator ni;
 	node_set_t::const_iterator  ai;
 	stringstream                ss;
@@ -734,7 +927,7 @@ GraphChain::dump () const
 
 	DEBUG_TRACE (DEBUG::Graph, " --- trigger list ---\n");
 	for (auto const& ni : _init_trigger_list) {
-		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2\n", ni->graph_node_name (), ni->init_refcount (this)));
+		DEBUG_TRACE (DEBUG::Graph, string_compose ("GraphNode: %1  refcount: %2 critical path: %3 usec\n", ni->graph_node_name (), ni->init_refcount (this), _critical_path.at (ni.get ())));
 	}
 
 	DEBUG_TRACE (DEBUG::Graph, string_compose ("final activation refcount: %1\n", _n_terminal_nodes));
@@ -146,6 +146,11 @@
 */
 static const size_t NBUFS = 4;
 
+/** Plugins are instantiated for this block size, the largest that
+ * is used with any engine and during export.
+ */
+static const int32_t lv2_max_block_length = 8192;
+
 using namespace std;
 using namespace ARDOUR;
 using namespace PBD;
@@ -607,7 +612,7 @@ LV2Plugin::init(const void* c_plugin, samplecnt_t rate)
 	LV2_URID atom_Float = _uri_map.uri_to_id(LV2_ATOM__Float);
 
 	static const int32_t _min_block_length = 1;   // may happen during split-cycles
-	static const int32_t _max_block_length = 8192; // max possible (with all engines and during export)
+	static const int32_t _max_block_length = lv2_max_block_length;
 	static const int32_t rt_policy = PBD_SCHED_FIFO;
 	static const int32_t rt_priority = pbd_absolute_rt_priority (PBD_SCHED_FIFO, AudioEngine::instance()->client_real_time_priority () - 1);
 	/* Consider updating max-block-size whenever the buffersize changes.
@@ -1024,6 +1029,12 @@ LV2Plugin::init(const void* c_plugin, samplecnt_t rate)
 	}
 }
 
+pframes_t
+LV2Plugin::max_block_size () const
+{
+	return lv2_max_block_length;
+}
+
 int
 LV2Plugin::set_block_size (pframes_t nframes)
 {
@@ -61,6 +61,7 @@ using namespace PBD;
 MidiModel::MidiModel (MidiSource& s)
 	: AutomatableSequence<TimeType> (s.session(), Temporal::TimeDomainProvider (Temporal::BeatTime))
 	, _midi_source (s)
+	, _edit_generation (0)
 {
 	_midi_source.InterpolationChanged.connect_same_thread (_midi_source_connections, boost::bind (&MidiModel::source_interpolation_changed, this, _1, _2));
 	_midi_source.AutomationStateChanged.connect_same_thread (_midi_source_connections, boost::bind (&MidiModel::source_automation_state_changed, this, _1, _2));
@@ -330,7 +331,7 @@ MidiModel::NoteDiffCommand::operator() ()
 		}
 	}
 
-	_model->ContentsChanged(); /* EMIT SIGNAL */
+	note_edits_done ();
 }
 
 void
@@ -440,6 +441,81 @@ MidiModel::NoteDiffCommand::undo ()
 		}
 	}
 
+	note_edits_done ();
+}
+
+/** Compute the span of time that is affected by this command, in either
+ * direction (do and undo). This includes the previous and current extent
+ * of all notes that are modified.
+ */
+void
+MidiModel::NoteDiffCommand::edited_span (TimeType& start, TimeType& end) const
+{
+	start = std::numeric_limits<TimeType>::max ();
+	end   = TimeType ();
+
+	for (NoteList::const_iterator i = _added_notes.begin(); i != _added_notes.end(); ++i) {
+		start = std::min (start, (*i)->time ());
+		end   = std::max (end, (*i)->end_time ());
+	}
+
+	for (NoteList::const_iterator i = _removed_notes.begin(); i != _removed_notes.end(); ++i) {
+		start = std::min (start, (*i)->time ());
+		end   = std::max (end, (*i)->end_time ());
+	}
+
+	for (set<NotePtr>::const_iterator i = side_effect_removals.begin(); i != side_effect_removals.end(); ++i) {
+		start = std::min (start, (*i)->time ());
+		end   = std::max (end, (*i)->end_time ());
+	}
+
+	/* start and length of a note may both change, use the latest
+	 * start and longest length of every note.
+	 */
+	std::map<NotePtr, std::pair<TimeType, TimeType> > extent;
+
+	for (ChangeList::const_iterator i = _changes.begin(); i != _changes.end(); ++i) {
+		if (!i->note) {
+			continue;
+		}
+
+		std::map<NotePtr, std::pair<TimeType, TimeType> >::iterator x = extent.find (i->note);
+		if (x == extent.end ()) {
+			x = extent.insert (make_pair (i->note, make_pair (i->note->time (), i->note->length ()))).first;
+			start = std::min (start, i->note->time ());
+		}
+
+		switch (i->property) {
+			case StartTime:
+				start = std::min (start, std::min (i->old_value.get_beats (), i->new_value.get_beats ()));
+				x->second.first = std::max (x->second.first, std::max (i->old_value.get_beats (), i->new_value.get_beats ()));
+				break;
+			case Length:
+				x->second.second = std::max (x->second.second, std::max (i->old_value.get_beats (), i->new_value.get_beats ()));
+				break;
+			default:
+				break;
+		}
+	}
+
+	for (std::map<NotePtr, std::pair<TimeType, TimeType> >::const_iterator x = extent.begin (); x != extent.end (); ++x) {
+		end = std::max (end, x->second.first + x->second.second);
+	}
+}
+
+void
+MidiModel::NoteDiffCommand::note_edits_done ()
+{
+	TimeType start, end;
+	edited_span (start, end);
+
+	if (_model->insert_merge_policy () != InsertMergeRelax) {
+		/* overlap resolution may have changed notes without recording it */
+		_model->contents_edited ();
+	} else if (start <= end) {
+		_model->notes_edited (start, end);
+	}
+
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
@@ -726,6 +802,7 @@ MidiModel::SysExDiffCommand::operator() ()
 		}
 	}
 
+	_model->contents_edited ();
 	_model->ContentsChanged (); /* EMIT SIGNAL */
 }
 
@@ -758,6 +835,7 @@ MidiModel::SysExDiffCommand::undo ()
 
 	}
 
+	_model->contents_edited ();
 	_model->ContentsChanged(); /* EMIT SIGNAL */
 }
 
@@ -985,6 +1063,7 @@ MidiModel::PatchChangeDiffCommand::operator() ()
 		}
 	}
 
+	_model->contents_edited ();
 	_model->ContentsChanged (); /* EMIT SIGNAL */
 }
 
@@ -1043,6 +1122,7 @@ MidiModel::PatchChangeDiffCommand::undo ()
 
 	}
 
+	_model->contents_edited ();
 	_model->ContentsChanged (); /* EMIT SIGNAL */
 }
 
@@ -1647,6 +1727,7 @@ MidiModel::source_interpolation_changed (Evoral::Parameter const& p, AutomationL
 		control(p)->list()->set_interpolation (s);
 	}
 	/* re-read MIDI */
+	contents_edited ();
 	ContentsChanged (); /* EMIT SIGNAL */
 }
 
@@ -1668,6 +1749,7 @@ MidiModel::source_automation_state_changed (Evoral::Parameter const& p, AutoStat
 		al->set_automation_state (s);
 	}
 	/* re-read MIDI */
+	contents_edited ();
 	ContentsChanged (); /* EMIT SIGNAL */
 }
 
@@ -1765,11 +1847,64 @@ MidiModel::transpose (NoteDiffCommand* c, const NotePtr note_ptr, int semitones)
 	c->change (note_ptr, NoteDiffCommand::NoteNumber, (uint8_t) new_note);
 }
 
+bool
+MidiModel::edited_span (uint64_t generation, TimeType& start, TimeType& end) const
+{
+	Glib::Threads::Mutex::Lock lm (_edit_span_lock);
+
+	if (_edit_spans.empty () || _edit_spans.front ().generation > generation + 1) {
+		/* history does not reach back far enough */
+		return false;
+	}
+
+	bool found = false;
+
+	for (std::deque<EditSpan>::const_iterator i = _edit_spans.begin (); i != _edit_spans.end (); ++i) {
+		if (i->generation <= generation) {
+			continue;
+		}
+		if (!i->known) {
+			return false;
+		}
+		if (!found) {
+			start = i->start;
+			end   = i->end;
+			found = true;
+		} else {
+			start = std::min (start, i->start);
+			end   = std::max (end, i->end);
+		}
+	}
+
+	return found;
+}
+
+void
+MidiModel::notes_edited (TimeType const& start, TimeType const& end)
+{
+	Glib::Threads::Mutex::Lock lm (_edit_span_lock);
+	_edit_spans.push_back (EditSpan (++_edit_generation, start, end, true));
+	if (_edit_spans.size () > 64) {
+		_edit_spans.pop_front ();
+	}
+}
+
+void
+MidiModel::contents_edited ()
+{
+	Glib::Threads::Mutex::Lock lm (_edit_span_lock);
+	_edit_spans.push_back (EditSpan (++_edit_generation, TimeType (), TimeType (), false));
+	if (_edit_spans.size () > 64) {
+		_edit_spans.pop_front ();
+	}
+}
+
 void
 MidiModel::control_list_marked_dirty ()
 {
 	AutomatableSequence<Temporal::Beats>::control_list_marked_dirty ();
 
+	contents_edited ();
 	ContentsChanged (); /* EMIT SIGNAL */
 }
 
@@ -22,6 +22,7 @@
 #include <algorithm>
 #include <cassert>
 #include <cstdlib>
+#include <cstring>
 #include <iostream>
 #include <utility>
 
@@ -270,7 +271,7 @@ MidiPlaylist::contained_automation()
 }
 
 void
-MidiPlaylist::render (MidiChannelFilter* filter)
+MidiPlaylist::render (MidiChannelFilter* filter, bool incremental)
 {
 	Playlist::RegionReadLock rl (this);
 
@@ -298,6 +299,17 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 		regs.push_back (mr);
 	}
 
+	RenderState state;
+	render_state (regs, filter, state);
+
+	if (incremental && render_changes (regs, state, filter)) {
+		_render_state = state;
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render (incremental), events: %1\n", _rendered.size()));
+		return;
+	}
+
+	_render_state = state;
+
 	/* RAII */
 	RTMidiBuffer::WriteProtectRender wpr (_rendered);
 
@@ -429,6 +441,331 @@ MidiPlaylist::render (MidiChannelFilter* filter)
 	DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("---- End MidiPlaylist::render, events: %1\n", _rendered.size()));
 }
 
+void
+MidiPlaylist::render_state (std::list<std::shared_ptr<MidiRegion>> const& regs, MidiChannelFilter* filter, RenderState& state) const
+{
+	state.valid            = true;
+	state.note_mode        = _note_mode;
+	state.filter           = filter;
+	state.filter_mode_mask = 0;
+	state.tempo_map        = Temporal::TempoMap::use ();
+
+	if (filter) {
+		ChannelMode mode;
+		uint16_t    mask;
+		filter->get_mode_and_mask (&mode, &mask);
+		state.filter_mode_mask = ((uint32_t) mode << 16) | mask;
+	}
+
+	for (auto const& mr : regs) {
+		std::shared_ptr<MidiModel> model (mr->model ());
+
+		if (!model || model->writing ()) {
+			/* still recording, the next render has to be complete */
+			state.valid = false;
+		}
+
+		RenderedRegion& rr (state.regions[mr.get ()]);
+
+		rr.region           = mr;
+		rr.model            = model.get ();
+		rr.model_generation = model ? model->edit_generation () : 0;
+		rr.first            = mr->position ().samples ();
+		rr.last             = mr->end ().samples ();
+		rr.start            = mr->start ();
+		rr.layer            = mr->layer ();
+		rr.opaque           = mr->opaque ();
+		rr.muted            = mr->muted ();
+	}
+}
+
+static size_t
+rendered_lower_bound (RTMidiBuffer const& rtmb, samplepos_t t)
+{
+	size_t lo = 0;
+	size_t hi = rtmb.size ();
+
+	while (lo < hi) {
+		size_t const mid = lo + (hi - lo) / 2;
+		if (rtmb[mid].timestamp < t) {
+			lo = mid + 1;
+		} else {
+			hi = mid;
+		}
+	}
+	return lo;
+}
+
+static inline bool
+is_note_on (uint8_t const* buf, uint32_t size)
+{
+	return size == 3 && (buf[0] & 0xf0) == MIDI_CMD_NOTE_ON && buf[2] > 0;
+}
+
+static inline bool
+is_note_off (uint8_t const* buf, uint32_t size)
+{
+	return size == 3 && ((buf[0] & 0xf0) == MIDI_CMD_NOTE_OFF || ((buf[0] & 0xf0) == MIDI_CMD_NOTE_ON && buf[2] == 0));
+}
+
+/** Re-render only the time-ranges that changed since the last render,
+ * and splice the result into _rendered.
+ *
+ * This handles added, removed or modified regions, and note-edits of
+ * a region's model. To keep this simple, it requires that the affected
+ * range does not overlap any other region, so that all events in the
+ * range belong to a single region and layering is not relevant.
+ *
+ * @return false if a complete render is required
+ */
+bool
+MidiPlaylist::render_changes (std::list<std::shared_ptr<MidiRegion>> const& regs, RenderState const& state, MidiChannelFilter* filter)
+{
+	RenderState const& prev (_render_state);
+
+	if (!prev.valid || !state.valid || _rendered.reversed ()) {
+		return false;
+	}
+
+	if (prev.note_mode != state.note_mode || prev.filter != state.filter || prev.filter_mode_mask != state.filter_mode_mask || prev.tempo_map != state.tempo_map) {
+		return false;
+	}
+
+	struct Window {
+		Window (MidiRegion const* k, samplepos_t f, samplepos_t l, std::shared_ptr<MidiRegion> const& r = std::shared_ptr<MidiRegion> ())
+			: key (k), first (f), last (l), region (r), notes_only (false) {}
+
+		MidiRegion const*           key;
+		samplepos_t                 first;
+		samplepos_t                 last;   // inclusive
+		std::shared_ptr<MidiRegion> region; // region to render, if any
+		bool                        notes_only;
+		Temporal::Beats             edit_start;
+		Temporal::Beats             edit_end;
+	};
+
+	std::vector<Window> windows;
+
+	for (auto const& r : state.regions) {
+		RenderedRegion const&       now (r.second);
+		std::shared_ptr<MidiRegion> mr (now.region.lock ());
+		RenderedRegions::const_iterator p = prev.regions.find (r.first);
+
+		if (p == prev.regions.end ()) {
+			/* new region */
+			windows.push_back (Window (r.first, now.first, now.last, mr));
+			continue;
+		}
+
+		RenderedRegion const& was (p->second);
+
+		if (was.region.lock () != mr || was.model != now.model
+		    || was.first != now.first || was.last != now.last || was.start != now.start
+		    || was.layer != now.layer || was.opaque != now.opaque || was.muted != now.muted) {
+			/* region was replaced, moved or trimmed */
+			if (was.first <= now.last && now.first <= was.last) {
+				windows.push_back (Window (r.first, std::min (was.first, now.first), std::max (was.last, now.last), mr));
+			} else {
+				windows.push_back (Window (r.first, was.first, was.last));
+				windows.push_back (Window (r.first, now.first, now.last, mr));
+			}
+			continue;
+		}
+
+		if (was.model_generation == now.model_generation) {
+			continue;
+		}
+
+		Temporal::Beats start, end;
+
+		if (!mr->model ()->edited_span (was.model_generation, start, end)) {
+			windows.push_back (Window (r.first, now.first, now.last, mr));
+			continue;
+		}
+
+		/* map model-time to the timeline */
+		Temporal::Beats const src_pos (mr->source_position ().beats ());
+		samplepos_t const     first = std::max (now.first, timepos_t (src_pos + start).samples ());
+		samplepos_t const     last  = std::min (now.last, timepos_t (src_pos + end).samples ());
+
+		if (first > last) {
+			/* edit is outside of the region's bounds */
+			continue;
+		}
+
+		Window w (r.first, first, last, mr);
+		w.notes_only = true;
+		w.edit_start = start;
+		w.edit_end   = end;
+		windows.push_back (w);
+	}
+
+	for (auto const& p : prev.regions) {
+		if (state.regions.find (p.first) == state.regions.end ()) {
+			/* removed region */
+			windows.push_back (Window (p.first, p.second.first, p.second.last));
+		}
+	}
+
+	if (windows.empty ()) {
+		return true;
+	}
+
+	std::sort (windows.begin (), windows.end (), [] (Window const& a, Window const& b) { return a.first < b.first; });
+
+	for (size_t n = 1; n < windows.size (); ++n) {
+		if (windows[n].first <= windows[n - 1].last) {
+			return false;
+		}
+	}
+
+	/* check that no other region has events in the given range */
+	auto overlaps_other = [&] (MidiRegion const* key, samplepos_t first, samplepos_t last) {
+		for (auto const& r : state.regions) {
+			if (r.first != key && r.second.first <= last && first <= r.second.last) {
+				return true;
+			}
+		}
+		for (auto const& r : prev.regions) {
+			if (r.first != key && r.second.first <= last && first <= r.second.last) {
+				return true;
+			}
+		}
+		return false;
+	};
+
+	for (auto const& w : windows) {
+		if (w.notes_only) {
+			/* old note-offs of the region are identified by tracking
+			 * the region's notes from its start.
+			 */
+			RenderedRegion const& rr (state.regions.find (w.key)->second);
+			if (overlaps_other (w.key, rr.first, rr.last)) {
+				return false;
+			}
+		} else if (overlaps_other (w.key, w.first, w.last)) {
+			return false;
+		}
+	}
+
+	EventsSortByTimeAndType<samplepos_t> cmp;
+	std::vector<Evoral::EventList<samplepos_t>> events (windows.size ());
+
+	for (size_t n = 0; n < windows.size (); ++n) {
+		Window const&                   w (windows[n]);
+		Evoral::EventList<samplepos_t>& evlist (events[n]);
+
+		if (!w.region) {
+			continue;
+		}
+
+		DEBUG_TRACE (DEBUG::MidiPlaylistIO, string_compose ("render %1 from %2 .. %3%4\n", w.region->name(), w.first, w.last, w.notes_only ? " (notes)" : ""));
+
+		if (!w.notes_only) {
+			w.region->render (evlist, 0, _note_mode, filter);
+			if (regs.size () > 1) {
+				evlist.sort (cmp);
+			}
+			continue;
+		}
+
+		/* Notes that started before the window are unchanged, keep their
+		 * note-offs. Other notes in the window are rendered again.
+		 * Events other than notes are not affected by note edits.
+		 */
+		uint8_t active[16][128];
+		memset (active, 0, sizeof (active));
+
+		size_t i = rendered_lower_bound (_rendered, state.regions.find (w.key)->second.first);
+
+		for (; i < _rendered.size () && _rendered[i].timestamp <= w.last; ++i) {
+			RTMidiBuffer::Item const& item (_rendered[i]);
+			uint32_t                  size;
+			uint8_t const*            buf = _rendered.bytes (item, size);
+
+			if (item.timestamp < w.first) {
+				if (is_note_on (buf, size)) {
+					++active[buf[0] & 0x0f][buf[1]];
+				} else if (is_note_off (buf, size) && active[buf[0] & 0x0f][buf[1]] > 0) {
+					--active[buf[0] & 0x0f][buf[1]];
+				}
+				continue;
+			}
+
+			if (is_note_on (buf, size)) {
+				continue;
+			}
+			if (is_note_off (buf, size)) {
+				if (active[buf[0] & 0x0f][buf[1]] == 0) {
+					continue;
+				}
+				--active[buf[0] & 0x0f][buf[1]];
+			}
+
+			evlist.write (item.timestamp, Evoral::MIDI_EVENT, size, buf);
+		}
+
+		/* read a bit beyond the edit, so that note-offs at the end of the
+		 * span are not replaced by note-offs of the stuck-note resolver.
+		 */
+		timepos_t const region_start (w.region->start ());
+		timepos_t const region_end (w.region->start () + w.region->length ());
+		timepos_t const read_start (std::max (region_start, timepos_t (w.edit_start)));
+		timepos_t const read_end (std::min (region_end, timepos_t (w.edit_end + Temporal::Beats (1, 0))));
+
+		if (read_start < read_end) {
+			Evoral::EventList<samplepos_t> notes;
+			w.region->render_range (notes, 0, _note_mode, read_start, read_start.distance (read_end), filter);
+
+			/* only keep note-offs of notes that start in the window,
+			 * the others were retained above.
+			 */
+			memset (active, 0, sizeof (active));
+
+			for (Evoral::EventList<samplepos_t>::iterator e = notes.begin (); e != notes.end (); ++e) {
+				Evoral::Event<samplepos_t>* ev (*e);
+				uint8_t const*              buf  = ev->buffer ();
+				bool                        keep = false;
+
+				if (ev->time () >= w.first && ev->time () <= w.last) {
+					if (is_note_on (buf, ev->size ())) {
+						++active[buf[0] & 0x0f][buf[1]];
+						keep = true;
+					} else if (is_note_off (buf, ev->size ()) && active[buf[0] & 0x0f][buf[1]] > 0) {
+						--active[buf[0] & 0x0f][buf[1]];
+						keep = true;
+					}
+				}
+
+				if (keep) {
+					evlist.push_back (ev);
+				} else {
+					delete ev;
+				}
+			}
+		}
+
+		evlist.sort (cmp);
+	}
+
+	{
+		RTMidiBuffer::WriteProtectRender wpr (_rendered);
+		wpr.acquire ();
+
+		for (size_t n = 0; n < windows.size (); ++n) {
+			_rendered.splice (windows[n].first, windows[n].last + 1, events[n]);
+		}
+	}
+
+	for (auto& evlist : events) {
+		for (Evoral::EventList<samplepos_t>::iterator e = evlist.begin (); e != evlist.end (); ++e) {
+			delete *e;
+		}
+	}
+
+	return true;
+}
+
 RTMidiBuffer*
 MidiPlaylist::rendered ()
 {
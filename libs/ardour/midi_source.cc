@@ -380,6 +380,7 @@ MidiSource::mark_midi_streaming_write_completed (const WriterLock&
 {
 	if (_model) {
 		_model->end_write (option, end);
+		_model->contents_edited ();
 
 		/* Make captured controls discrete to play back user input exactly. */
 		for (MidiModel::Controls::iterator i = _model->controls().begin(); i != _model->controls().end(); ++i) {
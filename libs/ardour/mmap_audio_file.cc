@@ -0,0 +1,407 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <fcntl.h>
+
+#ifndef PLATFORM_WINDOWS
+#include <csetjmp>
+#include <csignal>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include <glib.h>
+#include "pbd/gstdio_compat.h"
+
+#include "ardour/mmap_audio_file.h"
+
+using namespace ARDOUR;
+
+/* minimum number of sample-frames to request ahead of the current read */
+#define READ_AHEAD_FRAMES 65536
+
+#ifndef PLATFORM_WINDOWS
+/* Accessing pages of a mapped file beyond its end raises SIGBUS. Another
+ * process may truncate a file while it is mapped, so accesses to the map
+ * are wrapped in sigsetjmp(), and the handler jumps back if the faulting
+ * thread is in such a section. Any other SIGBUS is passed on.
+ */
+static thread_local sigjmp_buf* bus_error_jmp = 0;
+static struct sigaction         prev_sigbus_action;
+
+static void
+sigbus_handler (int sig, siginfo_t* info, void* ctx)
+{
+	if (bus_error_jmp) {
+		siglongjmp (*bus_error_jmp, 1);
+	}
+
+	if (prev_sigbus_action.sa_flags & SA_SIGINFO) {
+		if (prev_sigbus_action.sa_sigaction) {
+			prev_sigbus_action.sa_sigaction (sig, info, ctx);
+			return;
+		}
+	} else if (prev_sigbus_action.sa_handler != SIG_DFL && prev_sigbus_action.sa_handler != SIG_IGN) {
+		prev_sigbus_action.sa_handler (sig);
+		return;
+	}
+
+	/* restore the default action, the faulting access is repeated */
+	signal (SIGBUS, SIG_DFL);
+}
+
+static bool
+install_sigbus_handler ()
+{
+	struct sigaction sa;
+	memset (&sa, 0, sizeof (sa));
+	sa.sa_sigaction = sigbus_handler;
+	sa.sa_flags     = SA_SIGINFO | SA_NODEFER;
+	sigemptyset (&sa.sa_mask);
+	return sigaction (SIGBUS, &sa, &prev_sigbus_action) == 0;
+}
+#endif
+
+static inline uint16_t
+le16 (uint8_t const* p)
+{
+	return p[0] | (p[1] << 8);
+}
+
+static inline uint32_t
+le32 (uint8_t const* p)
+{
+	return p[0] | (p[1] << 8) | (p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+static inline uint64_t
+le64 (uint8_t const* p)
+{
+	return le32 (p) | ((uint64_t)le32 (p + 4) << 32);
+}
+
+static inline uint32_t
+be32 (uint8_t const* p)
+{
+	return ((uint32_t)p[0] << 24) | (p[1] << 16) | (p[2] << 8) | p[3];
+}
+
+static inline uint64_t
+be64 (uint8_t const* p)
+{
+	return ((uint64_t)be32 (p) << 32) | be32 (p + 4);
+}
+
+MMapAudioFile*
+MMapAudioFile::open (std::string const& path, uint32_t channels, samplecnt_t frames)
+{
+#ifdef PLATFORM_WINDOWS
+	return 0;
+#else
+	if (sizeof (void*) < 8 || channels == 0) {
+		/* do not exhaust the address space of 32bit systems */
+		return 0;
+	}
+
+	/* thread-safe, once */
+	static bool const sigbus_handler_installed = install_sigbus_handler ();
+	if (!sigbus_handler_installed) {
+		return 0;
+	}
+
+	GStatBuf statbuf;
+	if (g_stat (path.c_str (), &statbuf) != 0 || statbuf.st_size < 12) {
+		return 0;
+	}
+
+	int fd = g_open (path.c_str (), O_RDONLY, 0444);
+	if (fd == -1) {
+		return 0;
+	}
+
+	size_t   len  = statbuf.st_size;
+	uint8_t* addr = (uint8_t*)mmap (NULL, len, PROT_READ, MAP_SHARED, fd, 0);
+
+	/* the map keeps a reference to the file */
+	::close (fd);
+
+	if (addr == MAP_FAILED) {
+		return 0;
+	}
+
+	size_t   offset = 0;
+	uint64_t size   = 0;
+	uint32_t n_chn  = 0;
+	bool     ok     = false;
+
+	sigjmp_buf jb;
+	if (sigsetjmp (jb, 1)) {
+		/* truncated since the stat () above */
+		bus_error_jmp = 0;
+		munmap (addr, len);
+		return 0;
+	}
+	bus_error_jmp = &jb;
+
+	if (!memcmp (addr, "RIFF", 4) || !memcmp (addr, "RF64", 4)) {
+		ok = G_BYTE_ORDER == G_LITTLE_ENDIAN && parse_riff (addr, len, offset, size, n_chn);
+	} else if (!memcmp (addr, "caff", 4)) {
+		ok = parse_caf (addr, len, offset, size, n_chn);
+	}
+
+	bus_error_jmp = 0;
+
+	/* only use the map if it agrees with what libsndfile found */
+	if (ok) {
+		ok = n_chn == channels
+		  && offset % sizeof (float) == 0
+		  && size >= (uint64_t)frames * channels * sizeof (float)
+		  && offset + (uint64_t)frames * channels * sizeof (float) <= len;
+	}
+
+	if (!ok) {
+		munmap (addr, len);
+		return 0;
+	}
+
+	return new MMapAudioFile (addr, len, offset, channels, frames);
+#endif
+}
+
+MMapAudioFile::MMapAudioFile (uint8_t const* addr, size_t len, size_t data_offset, uint32_t channels, samplecnt_t frames)
+	: _addr (addr)
+	, _length (len)
+	, _data ((float const*)(addr + data_offset))
+	, _channels (channels)
+	, _frames (frames)
+	, _last_read (0)
+	, _advised_start (0)
+	, _advised_end (0)
+	, _reverse (false)
+	, _failed (false)
+{
+#ifndef PLATFORM_WINDOWS
+	madvise (const_cast<uint8_t*> (_addr), _length, MADV_SEQUENTIAL);
+#endif
+}
+
+MMapAudioFile::~MMapAudioFile ()
+{
+#ifndef PLATFORM_WINDOWS
+	munmap (const_cast<uint8_t*> (_addr), _length);
+#endif
+}
+
+bool
+MMapAudioFile::parse_riff (uint8_t const* addr, size_t len, size_t& offset, uint64_t& size, uint32_t& channels)
+{
+	if (memcmp (addr + 8, "WAVE", 4)) {
+		return false;
+	}
+
+	bool const rf64     = !memcmp (addr, "RF64", 4);
+	uint64_t   rf64_len = 0;
+	bool       have_fmt = false;
+	size_t     pos      = 12;
+
+	while (pos + 8 <= len) {
+		uint8_t const* ck    = addr + pos;
+		uint32_t const ck_sz = le32 (ck + 4);
+
+		if (!memcmp (ck, "ds64", 4) && ck_sz >= 24 && pos + 32 <= len) {
+			rf64_len = le64 (ck + 16);
+		} else if (!memcmp (ck, "fmt ", 4) && ck_sz >= 16 && pos + 24 <= len) {
+			uint16_t tag  = le16 (ck + 8);
+			uint16_t bits = le16 (ck + 22);
+			if (tag == 0xfffe && ck_sz >= 40 && pos + 34 <= len) {
+				/* WAVE_FORMAT_EXTENSIBLE, first two bytes of the sub-format GUID */
+				tag = le16 (ck + 32);
+			}
+			if (tag != 3 /* WAVE_FORMAT_IEEE_FLOAT */ || bits != 32) {
+				return false;
+			}
+			channels = le16 (ck + 10);
+			have_fmt = true;
+		} else if (!memcmp (ck, "data", 4)) {
+			if (!have_fmt) {
+				return false;
+			}
+			offset = pos + 8;
+			size   = (rf64 && ck_sz == 0xffffffff) ? rf64_len : ck_sz;
+			return true;
+		}
+
+		pos += 8 + (uint64_t)ck_sz + (ck_sz & 1);
+	}
+
+	return false;
+}
+
+bool
+MMapAudioFile::parse_caf (uint8_t const* addr, size_t len, size_t& offset, uint64_t& size, uint32_t& channels)
+{
+	bool   have_desc = false;
+	size_t pos       = 8;
+
+	while (pos + 12 <= len) {
+		uint8_t const* ck    = addr + pos;
+		uint64_t const ck_sz = be64 (ck + 4);
+
+		if (!memcmp (ck, "desc", 4) && ck_sz >= 32 && pos + 44 <= len) {
+			uint32_t const flags = be32 (ck + 24);
+			bool const     is_le = flags & 2; /* kCAFLinearPCMFormatFlagIsLittleEndian */
+
+			if (memcmp (ck + 20, "lpcm", 4) || !(flags & 1) || be32 (ck + 40) != 32) {
+				return false;
+			}
+			if (is_le != (G_BYTE_ORDER == G_LITTLE_ENDIAN)) {
+				return false;
+			}
+			channels  = be32 (ck + 36);
+			have_desc = true;
+		} else if (!memcmp (ck, "data", 4)) {
+			if (!have_desc || (ck_sz != UINT64_MAX && ck_sz < 4)) {
+				return false;
+			}
+			/* skip the 4 byte edit count */
+			offset = pos + 16;
+			size   = ck_sz == UINT64_MAX ? len - std::min (offset, len) : ck_sz - 4;
+			return true;
+		}
+
+		if (ck_sz > len) {
+			return false;
+		}
+		pos += 12 + ck_sz;
+	}
+
+	return false;
+}
+
+void
+MMapAudioFile::advise (samplepos_t start, samplecnt_t cnt) const
+{
+#ifndef PLATFORM_WINDOWS
+	bool const        reverse = start < _last_read;
+	samplecnt_t const window  = 4 * std::max<samplecnt_t> (cnt, READ_AHEAD_FRAMES);
+
+	_last_read = start;
+
+	if (reverse != _reverse) {
+		/* the kernel only reads ahead forward, disable it when reading backwards */
+		_reverse       = reverse;
+		_advised_start = _advised_end = 0;
+		madvise (const_cast<uint8_t*> (_addr), _length, reverse ? MADV_RANDOM : MADV_SEQUENTIAL);
+	}
+
+	samplepos_t s, e;
+
+	if (reverse) {
+		if (start >= _advised_start + window / 2 && start + cnt <= _advised_end) {
+			return;
+		}
+		s = std::max<samplepos_t> (0, start - window);
+		e = start + cnt;
+	} else {
+		if (start >= _advised_start && start + cnt + window / 2 <= _advised_end) {
+			return;
+		}
+		s = start;
+		e = std::min<samplepos_t> (_frames, start + cnt + window);
+	}
+
+	if (e <= s) {
+		return;
+	}
+
+	_advised_start = s;
+	_advised_end   = e;
+
+	static size_t const page = sysconf (_SC_PAGESIZE);
+
+	size_t b0 = (uint8_t const*)(_data + s * _channels) - _addr;
+	size_t b1 = (uint8_t const*)(_data + e * _channels) - _addr;
+
+	b0 -= b0 % page;
+
+	madvise (const_cast<uint8_t*> (_addr) + b0, std::min (b1, _length) - b0, MADV_WILLNEED);
+#endif
+}
+
+bool
+MMapAudioFile::read (Sample* dst, samplepos_t start, samplecnt_t cnt, uint32_t chn, float gain) const
+{
+	assert (chn < _channels);
+	assert (start >= 0 && start + cnt <= _frames);
+
+	if (_failed) {
+		return false;
+	}
+
+#ifndef PLATFORM_WINDOWS
+	advise (start, cnt);
+
+	sigjmp_buf jb;
+	if (sigsetjmp (jb, 1)) {
+		/* the file was truncated, do not use the map again */
+		bus_error_jmp = 0;
+		_failed       = true;
+		return false;
+	}
+	bus_error_jmp = &jb;
+
+	copy (dst, start, cnt, chn, gain);
+
+	bus_error_jmp = 0;
+	return true;
+#else
+	return false;
+#endif
+}
+
+void
+MMapAudioFile::copy (Sample* dst, samplepos_t start, samplecnt_t cnt, uint32_t chn, float gain) const
+{
+	float const* src = _data + start * _channels + chn;
+
+	if (_channels == 1) {
+		if (gain == 1.f) {
+			memcpy (dst, src, sizeof (Sample) * cnt);
+		} else {
+			for (samplecnt_t n = 0; n < cnt; ++n) {
+				dst[n] = src[n] * gain;
+			}
+		}
+		return;
+	}
+
+	if (gain == 1.f) {
+		for (samplecnt_t n = 0; n < cnt; ++n) {
+			dst[n] = *src;
+			src += _channels;
+		}
+	} else {
+		for (samplecnt_t n = 0; n < cnt; ++n) {
+			dst[n] = *src * gain;
+			src += _channels;
+		}
+	}
+}
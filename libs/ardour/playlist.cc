@@ -45,6 +45,7 @@
 #include "ardour/playlist_source.h"
 #include "ardour/region.h"
 #include "ardour/region_factory.h"
+#include "ardour/region_index.h"
 #include "ardour/region_sorters.h"
 #include "ardour/session.h"
 #include "ardour/session_playlists.h"
@@ -351,6 +352,7 @@ Playlist::init (bool hide)
 	_combine_ops                = 0;
 
 	_refcnt.store (0);
+	_region_index_generation.store (0);
 
 	_end_space = timecnt_t (_type == DataType::AUDIO ? Temporal::AudioTime : Temporal::BeatTime);
 	_playlist_shift_active = false;
@@ -788,6 +790,7 @@ Playlist::add_region_internal (std::shared_ptr<Region> region, timepos_t const &
 
 	regions.insert (upper_bound (regions.begin (), regions.end (), region, cmp), region);
 	all_regions.insert (region);
+	invalidate_region_index ();
 
 	if (!holding_state ()) {
 		/* layers get assigned from XML state, and are not reset during undo/redo */
@@ -847,6 +850,7 @@ Playlist::remove_region_internal (std::shared_ptr<Region> region, ThawList& thaw
 		if (*i == region) {
 
 			regions.erase (i);
+			invalidate_region_index ();
 
 			if (!holding_state ()) {
 				relayer ();
@@ -1679,6 +1683,11 @@ Playlist::region_changed_proxy (const PropertyChange& what_changed, std::weak_pt
 		return;
 	}
 
+	/* bounds may have changed without the region list being re-sorted
+	 * (e.g. while rippling), so any cached index is potentially stale.
+	 */
+	invalidate_region_index ();
+
 	/* this makes a virtual call to the right kind of playlist ... */
 
 	region_changed (what_changed, region);
@@ -1825,6 +1834,19 @@ Playlist::count_regions_at (timepos_t const & pos) const
 	RegionReadLock rlock (const_cast<Playlist*> (this));
 	uint32_t       cnt = 0;
 
+	std::shared_ptr<RegionIndex const> idx (region_index ());
+
+	if (idx) {
+		std::vector<std::shared_ptr<Region> > candidates;
+		idx->find (pos, pos, candidates);
+		for (auto const & r : candidates) {
+			if (r->covers (pos)) {
+				cnt++;
+			}
+		}
+		return cnt;
+	}
+
 	for (auto const & r : regions) {
 		if (r->covers (pos)) {
 			cnt++;
@@ -1946,6 +1968,19 @@ Playlist::find_regions_at (timepos_t const & pos)
 
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
+	std::shared_ptr<RegionIndex const> idx (region_index ());
+
+	if (idx) {
+		std::vector<std::shared_ptr<Region> > candidates;
+		idx->find (pos, pos, candidates);
+		for (auto & r : candidates) {
+			if (r->covers (pos)) {
+				rlist->push_back (r);
+			}
+		}
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->covers (pos)) {
 			rlist->push_back (r);
@@ -1997,6 +2032,20 @@ Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end
 {
 	std::shared_ptr<RegionList> rlist (new RegionList);
 
+	std::shared_ptr<RegionIndex const> idx (region_index ());
+
+	if (idx) {
+		/* the index uses inclusive ends, a superset of Region::coverage() */
+		std::vector<std::shared_ptr<Region> > candidates;
+		idx->find (start, end, candidates);
+		for (auto & r : candidates) {
+			if (r->coverage (start, end) != Temporal::OverlapNone) {
+				rlist->push_back (r);
+			}
+		}
+		return rlist;
+	}
+
 	for (auto & r : regions) {
 		if (r->coverage (start, end) != Temporal::OverlapNone) {
 			rlist->push_back (r);
@@ -2006,6 +2055,45 @@ Playlist::regions_touched_locked (timepos_t const & start, timepos_t const & end
 	return rlist;
 }
 
+std::shared_ptr<RegionIndex const>
+Playlist::region_index () const
+{
+	/* Caller must hold lock */
+
+	/* below this size a linear scan of the list is cheaper than
+	 * (re)building and querying the index.
+	 */
+	static const size_t min_indexed_regions = 32;
+
+	if (regions.size () < min_indexed_regions) {
+		return std::shared_ptr<RegionIndex const> ();
+	}
+
+	uint64_t const gen = _region_index_generation.load ();
+
+	std::shared_ptr<RegionIndex const> idx (std::atomic_load (&_region_index));
+
+	if (idx && idx->generation () == gen) {
+		return idx;
+	}
+
+	/* Several readers may get here concurrently; each builds its own
+	 * copy and the last one to publish wins. If the playlist was modified
+	 * meanwhile the published index is already marked stale by its
+	 * generation and will be replaced by the next reader.
+	 */
+	idx.reset (new RegionIndex (regions.begin (), regions.end (), gen));
+	std::atomic_store (&_region_index, idx);
+
+	return idx;
+}
+
+void
+Playlist::invalidate_region_index ()
+{
+	_region_index_generation.fetch_add (1);
+}
+
 samplepos_t
 Playlist::find_next_transient (timepos_t const & from, int dir)
 {
@@ -2719,6 +2807,7 @@ Playlist::relayer ()
 	 * probably keep a note of the top layer last time we relayered, and check that,
 	 * but premature optimisation &c...
 	 */
+	invalidate_region_index ();
 	notify_layering_changed ();
 
 	/* This relayer() may have been called as a result of a region removal, in which
@@ -3071,7 +3160,20 @@ Playlist::foreach_region (boost::function<void(std::shared_ptr<Region>)> func)
 bool
 Playlist::has_region_at (timepos_t const & p) const
 {
-	RegionReadLock (const_cast<Playlist*> (this));
+	RegionReadLock rlock (const_cast<Playlist*> (this));
+
+	std::shared_ptr<RegionIndex const> idx (region_index ());
+
+	if (idx) {
+		std::vector<std::shared_ptr<Region> > candidates;
+		idx->find (p, p, candidates);
+		for (auto const & r : candidates) {
+			if (r->covers (p)) {
+				return true;
+			}
+		}
+		return false;
+	}
 
 	RegionList::const_iterator i = regions.begin ();
 	while (i != regions.end () && !(*i)->covers (p)) {
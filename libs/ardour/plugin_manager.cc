@@ -69,6 +69,7 @@
 #include <glibmm/fileutils.h>
 
 #include "pbd/convert.h"
+#include "pbd/cpus.h"
 #include "pbd/file_utils.h"
 #include "pbd/tokenizer.h"
 #include "pbd/whitespace.h"
@@ -701,6 +702,179 @@ PluginManager::reset_scan_cancel_state (bool single)
 	_enable_scan_timeout     = false;
 }
 
+#if (defined WINDOWS_VST_SUPPORT || defined MACVST_SUPPORT || defined LXVST_SUPPORT || defined VST3_SUPPORT)
+
+/** A scanner-app process of a parallel scan */
+struct PluginManager::ScannerJob
+{
+	ScannerJob (std::string const& b, std::string const& m, PSLEPtr const& p)
+		: bundle (b)
+		, module (m)
+		, psle (p)
+		, scanner (0)
+		, timeout (0)
+		, notime (true)
+		, result (Pending)
+	{}
+
+	~ScannerJob ()
+	{
+		delete scanner;
+	}
+
+	enum Result {
+		Pending,
+		Completed,
+		Failed,
+		TimedOut,
+		Cancelled
+	};
+
+	std::string           bundle; // path passed to the scanner app
+	std::string           module; // cache-file and blacklist key
+	PSLEPtr               psle;
+	ARDOUR::SystemExec*   scanner;
+	std::stringstream     log;
+	PBD::ScopedConnection connection;
+	int                   timeout; // deciseconds
+	bool                  notime;
+	Result                result;
+};
+
+static void scanner_job_log (std::string msg, std::stringstream* ss)
+{
+	*ss << msg;
+}
+
+size_t
+PluginManager::scanner_jobs () const
+{
+	uint32_t n = Config->get_plugin_scan_jobs ();
+	if (n == 0) {
+		n = hardware_concurrency ();
+	}
+	return std::max<uint32_t> (1, n);
+}
+
+/* Run up to scanner_jobs() scanner-apps concurrently. Every process has its
+ * own timeout. Cancelling one plugin (from the GUI) terminates the oldest
+ * running process.
+ *
+ * Black/whitelisting and reading the resulting cache-files is left to the
+ * caller, this function only runs processes and collects their output.
+ */
+void
+PluginManager::run_scanner_jobs (std::string const& scanner_bin, std::string const& type, std::list<ScannerJob>& jobs)
+{
+	size_t const max_jobs = scanner_jobs ();
+	size_t const n_jobs   = jobs.size ();
+	size_t       n        = 0;
+
+	std::list<ScannerJob>::iterator next = jobs.begin ();
+	std::list<ScannerJob*>          running;
+
+	while (next != jobs.end () || !running.empty ()) {
+
+		/* launch new processes */
+		while (running.size () < max_jobs && next != jobs.end () && !_cancel_scan_all) {
+			ScannerJob& j = *next++;
+
+			ARDOUR::PluginScanMessage (string_compose (_("%1 (%2 / %3)"), type, ++n, n_jobs), j.bundle, true);
+
+			char **argp= (char**) calloc (5, sizeof (char*));
+			argp[0] = strdup (scanner_bin.c_str ());
+			argp[1] = strdup ("-f");
+			if (Config->get_verbose_plugin_scan()) {
+				argp[2] = strdup ("-v");
+			} else {
+				argp[2] = strdup ("-f");
+			}
+			argp[3] = strdup (j.bundle.c_str ());
+			argp[4] = 0;
+
+			j.scanner = new ARDOUR::SystemExec (scanner_bin, argp);
+			j.scanner->ReadStdout.connect_same_thread (j.connection, boost::bind (&scanner_job_log, _1, &j.log));
+
+			if (j.scanner->start (ARDOUR::SystemExec::MergeWithStdin)) {
+				j.psle->msg (PluginScanLogEntry::Error, string_compose (_("Cannot launch VST scanner app '%1': %2"), scanner_bin, strerror (errno)));
+				j.result = ScannerJob::Failed;
+				continue;
+			}
+
+			j.timeout = _enable_scan_timeout ? 1 + Config->get_plugin_scan_timeout() : 0; /* deciseconds */
+			j.notime  = (j.timeout <= 0);
+			running.push_back (&j);
+		}
+
+		if (_cancel_scan_all) {
+			/* do not start any more processes */
+			for (; next != jobs.end (); ++next) {
+				next->psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+				next->result = ScannerJob::Cancelled;
+			}
+		}
+
+		if (running.empty ()) {
+			continue;
+		}
+
+		Glib::usleep (100000);
+
+		/* A "skip" request from the GUI terminates only the first (oldest)
+		 * process that is still running after finished ones were collected.
+		 */
+		bool cancel_one = _cancel_scan_one;
+		_cancel_scan_one = false;
+
+		for (std::list<ScannerJob*>::iterator i = running.begin (); i != running.end ();) {
+			ScannerJob& j = **i;
+
+			if (!j.scanner->is_running ()) {
+				j.psle->msg (PluginScanLogEntry::OK, j.log.str());
+				j.result = ScannerJob::Completed;
+				i = running.erase (i);
+				continue;
+			}
+
+			if (!j.notime && no_timeout ()) {
+				j.notime  = true;
+				j.timeout = -1;
+			} else if (j.notime && !no_timeout() && _enable_scan_timeout) {
+				j.notime  = false;
+				j.timeout = 1 + Config->get_plugin_scan_timeout ();
+			}
+
+			if (j.timeout > -864000) {
+				--j.timeout;
+			}
+
+			if (i == running.begin ()) {
+				ARDOUR::PluginScanTimeout (j.timeout);
+			}
+
+			if (_cancel_scan_all || cancel_one || (!j.notime && j.timeout == 0)) {
+				j.scanner->terminate ();
+				j.psle->msg (PluginScanLogEntry::OK, j.log.str());
+				if (_cancel_scan_all || cancel_one) {
+					j.psle->msg (PluginScanLogEntry::New, "Scan was cancelled.");
+					j.result = ScannerJob::Cancelled;
+					cancel_one = false;
+				} else {
+					j.psle->msg (PluginScanLogEntry::TimeOut, "Scan Timed Out.");
+					j.result = ScannerJob::TimedOut;
+				}
+				i = running.erase (i);
+				continue;
+			}
+			++i;
+		}
+	}
+
+	reset_scan_cancel_state (true);
+}
+
+#endif
+
 void
 PluginManager::clear_vst_cache ()
 {
@@ -1478,6 +1652,53 @@ static void vst2_whitelist (string module_path)
 	Glib::file_set_contents (fn, bl);
 }
 
+void
+PluginManager::vst2_scan_parallel (std::vector<std::string> const& paths, ARDOUR::PluginType type, std::set<std::string>& scanned)
+{
+	std::list<ScannerJob> jobs;
+
+	for (std::vector<std::string>::const_iterator i = paths.begin (); i != paths.end (); ++i) {
+		if (vst2_is_blacklisted (*i) || !vst2_valid_cache_file (*i).empty ()) {
+			/* unchanged since the last scan */
+			continue;
+		}
+		PSLEPtr psle (scan_log_entry (type, *i));
+		psle->reset ();
+		vst2_blacklist (*i);
+		jobs.emplace_back (*i, *i, psle);
+	}
+
+	if (jobs.empty ()) {
+		return;
+	}
+
+	run_scanner_jobs (vst2_scanner_bin_path, _("VST2"), jobs);
+
+	for (std::list<ScannerJob>::iterator j = jobs.begin (); j != jobs.end (); ++j) {
+		scanned.insert (j->bundle);
+		switch (j->result) {
+			case ScannerJob::Completed:
+				if (vst2_valid_cache_file (j->module).empty ()) {
+					/* leave the plugin blacklisted */
+					j->psle->msg (PluginScanLogEntry::Error, _("Scan Failed."));
+					j->psle->msg (PluginScanLogEntry::Blacklisted);
+				} else {
+					/* the scanner app does not touch the blacklist,
+					 * the cache is read by vst2_discover () */
+					vst2_whitelist (j->module);
+				}
+				break;
+			case ScannerJob::Failed:
+				break;
+			default:
+				/* may be partially written */
+				g_unlink (vst2_cache_file (j->module).c_str ());
+				vst2_whitelist (j->module);
+				break;
+		}
+	}
+}
+
 static void vst2_scanner_log (std::string msg, std::stringstream* ss)
 {
 	*ss << msg;
@@ -1785,12 +2006,18 @@ PluginManager::windows_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> scanned;
+	if (!cache_only && !vst2_scanner_bin_path.empty () && scanner_jobs () > 1) {
+		vst2_scan_parallel (plugin_objects, Windows_VST, scanned);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
 		reset_scan_cancel_state (true);
-		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
-		vst2_discover (*x, Windows_VST, cache_only || cancelled());
+		bool const scan = !cache_only && !cancelled () && scanned.find (*x) == scanned.end ();
+		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, scan);
+		vst2_discover (*x, Windows_VST, !scan);
 	}
 
 	return ret;
@@ -1868,12 +2095,18 @@ PluginManager::mac_vst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> scanned;
+	if (!cache_only && !vst2_scanner_bin_path.empty () && scanner_jobs () > 1) {
+		vst2_scan_parallel (plugin_objects, MacVST, scanned);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
 		reset_scan_cancel_state (true);
-		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
-		vst2_discover (*x, MacVST, cache_only || cancelled());
+		bool const scan = !cache_only && !cancelled () && scanned.find (*x) == scanned.end ();
+		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, scan);
+		vst2_discover (*x, MacVST, !scan);
 	}
 
 	return 0;
@@ -1928,12 +2161,18 @@ PluginManager::lxvst_discover_from_path (string path, bool cache_only)
 	sort (plugin_objects.begin (), plugin_objects.end ());
 	plugin_objects.erase (unique (plugin_objects.begin (), plugin_objects.end ()), plugin_objects.end ());
 
+	std::set<std::string> scanned;
+	if (!cache_only && !vst2_scanner_bin_path.empty () && scanner_jobs () > 1) {
+		vst2_scan_parallel (plugin_objects, LXVST, scanned);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (x = plugin_objects.begin(); x != plugin_objects.end (); ++x, ++n) {
 		reset_scan_cancel_state (true);
-		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, !cache_only && !cancelled());
-		vst2_discover (*x, LXVST, cache_only || cancelled());
+		bool const scan = !cache_only && !cancelled () && scanned.find (*x) == scanned.end ();
+		ARDOUR::PluginScanMessage (string_compose (_("VST2 (%1 / %2)"), n, all_modules), *x, scan);
+		vst2_discover (*x, LXVST, !scan);
 	}
 
 	return 0;
@@ -2078,18 +2317,77 @@ PluginManager::vst3_discover_from_path (string const& path, bool cache_only)
 
 	find_paths_matching_filter (plugin_objects, paths, vst3_filter, 0, false, true, true);
 
+	/* modules that were (re)scanned concurrently, only their cache-files remain to be read */
+	std::set<std::string> scanned;
+	if (!cache_only && !vst3_scanner_bin_path.empty () && scanner_jobs () > 1) {
+		vst3_scan_parallel (plugin_objects, scanned);
+	}
+
 	size_t n = 1;
 	size_t all_modules = plugin_objects.size ();
 	for (vector<string>::iterator i = plugin_objects.begin(); i != plugin_objects.end (); ++i, ++n) {
 		DEBUG_TRACE (DEBUG::PluginManager, string_compose ("VST3: discover '%1'\n", *i));
 		reset_scan_cancel_state (true);
-		ARDOUR::PluginScanMessage (string_compose (_("VST3 (%1 / %2)"), n, all_modules), *i, !cache_only && !cancelled());
-		vst3_discover (*i, cache_only || cancelled ());
+		bool const scan = !cache_only && !cancelled () && scanned.find (*i) == scanned.end ();
+		ARDOUR::PluginScanMessage (string_compose (_("VST3 (%1 / %2)"), n, all_modules), *i, scan);
+		vst3_discover (*i, !scan);
 	}
 
 	return cancelled() ? -1 : 0;
 }
 
+void
+PluginManager::vst3_scan_parallel (std::vector<std::string> const& bundles, std::set<std::string>& scanned)
+{
+	std::list<ScannerJob> jobs;
+
+	for (std::vector<std::string>::const_iterator i = bundles.begin (); i != bundles.end (); ++i) {
+		string module_path = module_path_vst3 (*i);
+		if (module_path.empty () || module_path == "-1" || vst3_is_blacklisted (module_path)) {
+			continue;
+		}
+		if (!vst3_valid_cache_file (module_path).empty ()) {
+			/* unchanged since the last scan */
+			continue;
+		}
+		PSLEPtr psle (scan_log_entry (VST3, *i));
+		psle->reset ();
+		vst3_blacklist (module_path);
+		psle->msg (PluginScanLogEntry::OK, string_compose ("VST3 module-path '%1'", module_path));
+		jobs.emplace_back (*i, module_path, psle);
+	}
+
+	if (jobs.empty ()) {
+		return;
+	}
+
+	run_scanner_jobs (vst3_scanner_bin_path, _("VST3"), jobs);
+
+	for (std::list<ScannerJob>::iterator j = jobs.begin (); j != jobs.end (); ++j) {
+		scanned.insert (j->bundle);
+		switch (j->result) {
+			case ScannerJob::Completed:
+				if (vst3_valid_cache_file (j->module).empty ()) {
+					/* leave the module blacklisted */
+					j->psle->msg (PluginScanLogEntry::Blacklisted);
+					j->psle->msg (PluginScanLogEntry::Error, _("Scan Failed."));
+				} else {
+					/* the scanner app does not touch the blacklist,
+					 * the cache is read by vst3_discover () */
+					vst3_whitelist (j->module);
+				}
+				break;
+			case ScannerJob::Failed:
+				break;
+			default:
+				/* may be partially written */
+				g_unlink (vst3_cache_file (j->module).c_str ());
+				vst3_whitelist (j->module);
+				break;
+		}
+	}
+}
+
 void
 PluginManager::vst3_plugin (string const& module_path, string const& bundle_path, VST3Info const& i)
 {
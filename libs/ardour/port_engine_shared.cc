@@ -33,6 +33,7 @@ BackendPort::BackendPort (PortEngineSharedImpl &b, const std::string& name, Port
 	: _backend (b)
 	, _name  (name)
 	, _flags (flags)
+	, _sources (new PortSources)
 {
 	_capture_latency_range.min = 0;
 	_capture_latency_range.max = 0;
@@ -97,6 +98,7 @@ void
 BackendPort::store_connection (BackendPortHandle port)
 {
 	_connections.insert (port);
+	update_sources ();
 }
 
 int
@@ -126,6 +128,7 @@ void BackendPort::remove_connection (BackendPortHandle port)
 	std::set<BackendPortPtr>::iterator it = _connections.find (port);
 	assert (it != _connections.end ());
 	_connections.erase (it);
+	update_sources ();
 }
 
 
@@ -137,6 +140,19 @@ void BackendPort::disconnect_all (BackendPortHandle self)
 		_backend.port_connect_callback (name(), (*it)->name(), false);
 		_connections.erase (it);
 	}
+	update_sources ();
+}
+
+void
+BackendPort::update_sources ()
+{
+	RCUWriter<PortSources>       writer (_sources);
+	std::shared_ptr<PortSources> sources = writer.get_copy ();
+
+	sources->clear ();
+	for (std::set<BackendPortPtr>::const_iterator it = _connections.begin (); it != _connections.end (); ++it) {
+		sources->push_back (it->get ());
+	}
 }
 
 bool
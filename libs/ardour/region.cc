@@ -451,6 +451,7 @@ Region::Region (std::shared_ptr<const Region> other, const SourceList& srcs)
 	_position_locked = false;
 
 	other->_first_edit = EditChangesName;
+	other->mark_state_changed ();
 
 	if (other->_extra_xml) {
 		_extra_xml = new XMLNode (*other->_extra_xml);
@@ -1467,10 +1468,49 @@ Region::state () const
 	return *node;
 }
 
+bool
+Region::state_cacheable () const
+{
+	/* region-fx state and nested sources can change without the region
+	 * being notified, and IDs are re-generated when saving templates.
+	 */
+	return !has_region_fx () && max_source_level () == 0 && !regenerate_xml_or_string_ids ();
+}
+
 XMLNode&
 Region::get_state () const
 {
-	return state ();
+	/* Saving a session with many regions is dominated by serializing
+	 * region properties, envelopes and fades. Most regions are unchanged
+	 * between saves, so keep a copy of the generated state and re-use it
+	 * until a property change is signalled (see Stateful::state_generation).
+	 *
+	 * Extra XML can be modified directly via Stateful::extra_xml() and is
+	 * always copied.
+	 */
+	if (!state_cacheable ()) {
+		Glib::Threads::Mutex::Lock lm (_state_cache_lock);
+		_state_cache.reset ();
+		return state ();
+	}
+
+	Glib::Threads::Mutex::Lock lm (_state_cache_lock);
+
+	uint64_t const gen = state_generation ();
+
+	if (!_state_cache || _state_cache_generation != gen) {
+		_state_cache.reset (&state ());
+		_state_cache->remove_nodes_and_delete (X_("Extra"));
+		_state_cache_generation = gen;
+	}
+
+	XMLNode* node = new XMLNode (*_state_cache);
+
+	if (_extra_xml) {
+		node->add_child_copy (*_extra_xml);
+	}
+
+	return *node;
 }
 
 int
@@ -1746,6 +1786,7 @@ Region::set_master_sources (const SourceList& srcs)
 
 	_master_sources = srcs;
 	assert (_sources.size() == _master_sources.size());
+	mark_state_changed ();
 
 	for (SourceList::const_iterator i = _master_sources.begin (); i != _master_sources.end(); ++i) {
 		(*i)->inc_use_count ();
@@ -2112,6 +2153,7 @@ Region::drop_sources ()
 
 	_master_sources.clear ();
 	_source_deleted_connections.drop_connections ();
+	mark_state_changed ();
 }
 
 void
@@ -2124,6 +2166,7 @@ Region::use_sources (SourceList const & s)
 		_master_sources.push_back (*i);
 		(*i)->inc_use_count ();
 	}
+	mark_state_changed ();
 	subscribe_to_source_drop ();
 }
 
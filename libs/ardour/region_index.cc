@@ -0,0 +1,120 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include "ardour/region.h"
+#include "ardour/region_index.h"
+
+using namespace ARDOUR;
+using namespace Temporal;
+
+RegionIndex::Entry::Entry (std::shared_ptr<Region> const & r, uint32_t o)
+	: start (r->position ())
+	, last (r->nt_last ())
+	, max_last (last)
+	, order (o)
+	, region (r)
+{
+}
+
+RegionIndex::RegionIndex (RegionList::const_iterator first, RegionList::const_iterator last, uint64_t generation)
+	: _generation (generation)
+{
+	_entries.reserve (std::distance (first, last));
+
+	uint32_t n = 0;
+	for (RegionList::const_iterator i = first; i != last; ++i) {
+		_entries.push_back (Entry (*i, n++));
+	}
+
+	/* the region list is kept sorted by position, but not while
+	 * rippling, nudging or shuffling. A stable sort keeps the
+	 * list-order of regions at the same position.
+	 */
+	std::stable_sort (_entries.begin (), _entries.end (), EntrySorter ());
+
+	if (!_entries.empty ()) {
+		build (0, _entries.size ());
+	}
+}
+
+timepos_t
+RegionIndex::build (size_t lo, size_t hi)
+{
+	/* caller guarantees lo < hi */
+	size_t const mid = lo + (hi - lo) / 2;
+	Entry&       e   = _entries[mid];
+
+	e.max_last = e.last;
+
+	if (lo < mid) {
+		e.max_last = std::max (e.max_last, build (lo, mid));
+	}
+	if (mid + 1 < hi) {
+		e.max_last = std::max (e.max_last, build (mid + 1, hi));
+	}
+
+	return e.max_last;
+}
+
+void
+RegionIndex::find (size_t lo, size_t hi, timepos_t const & start, timepos_t const & last, std::vector<Entry const*>& hits) const
+{
+	while (lo < hi) {
+		size_t const mid = lo + (hi - lo) / 2;
+		Entry const& e   = _entries[mid];
+
+		if (e.max_last < start) {
+			/* nothing in this sub-tree reaches the range */
+			return;
+		}
+
+		find (lo, mid, start, last, hits);
+
+		if (last < e.start) {
+			/* this and everything to the right starts after the range */
+			return;
+		}
+
+		if (start <= e.last) {
+			hits.push_back (&e);
+		}
+
+		/* tail-iterate into the right sub-tree */
+		lo = mid + 1;
+	}
+}
+
+void
+RegionIndex::find (timepos_t const & start, timepos_t const & last, std::vector<std::shared_ptr<Region> >& rv) const
+{
+	std::vector<Entry const*> hits;
+
+	find (0, _entries.size (), start, last, hits);
+
+	if (hits.size () > 1) {
+		std::sort (hits.begin (), hits.end (), [] (Entry const* a, Entry const* b) { return a->order < b->order; });
+	}
+
+	rv.reserve (rv.size () + hits.size ());
+
+	for (auto const & e : hits) {
+		rv.push_back (e->region);
+	}
+}
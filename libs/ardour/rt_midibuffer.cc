@@ -200,38 +200,44 @@ RTMidiBuffer::write (TimeType time, Evoral::EventType /*type*/, uint32_t size, c
 		}
 	}
 
-	_data[_size].timestamp = time;
+	set_item (_data[_size], time, size, buf);
+
+	++_size;
+
+	return size;
+}
+
+void
+RTMidiBuffer::set_item (Item& item, TimeType time, uint32_t size, const uint8_t* buf)
+{
+	item.timestamp = time;
 
 	if (size > 3) {
 
 		uint32_t off = store_blob (size, buf);
 
 		/* non-zero MSbit indicates that the data (more than 3 bytes) is not inline */
-		_data[_size].offset = (off | (1<<(CHAR_BIT-1)));
+		item.offset = (off | (1<<(CHAR_BIT-1)));
 
 	} else {
 
 		assert ((int) size == Evoral::midi_event_size (buf[0]));
 
 		/* zero MSbit indicates that the data (up to 3 bytes) is inline */
-		_data[_size].bytes[0] = 0;
+		item.bytes[0] = 0;
 
 		switch (size) {
 		case 3:
-			_data[_size].bytes[3] = buf[2];
+			item.bytes[3] = buf[2];
 			/* fallthru */
 		case 2:
-			_data[_size].bytes[2] = buf[1];
+			item.bytes[2] = buf[1];
 			/* fallthru */
 		case 1:
-			_data[_size].bytes[1] = buf[0];
+			item.bytes[1] = buf[0];
 			break;
 		}
 	}
-
-	++_size;
-
-	return size;
 }
 
 /* requires C++20 to be usable */
@@ -251,6 +257,36 @@ item_item_earlier (ARDOUR::RTMidiBuffer::Item const & item, ARDOUR::RTMidiBuffer
 	return item.timestamp < other.timestamp;
 }
 
+void
+RTMidiBuffer::splice (TimeType start, TimeType end, Evoral::EventList<TimeType> const& events)
+{
+	Item foo;
+
+	foo.timestamp = start;
+	size_t const first = lower_bound (_data, _data + _size, foo, item_item_earlier) - _data;
+	foo.timestamp = end;
+	size_t const last = lower_bound (_data + first, _data + _size, foo, item_item_earlier) - _data;
+
+	size_t const n_events = events.size ();
+	size_t const size     = _size - (last - first) + n_events;
+
+	if (size >= _capacity) {
+		resize (size + 1024);
+	}
+
+	if (_size > last && first + n_events != last) {
+		memmove (&_data[first + n_events], &_data[last], (_size - last) * sizeof (Item));
+	}
+
+	size_t n = first;
+	for (Evoral::EventList<TimeType>::const_iterator e = events.begin (); e != events.end (); ++e, ++n) {
+		assert ((*e)->time () >= start && (*e)->time () < end);
+		set_item (_data[n], (*e)->time (), (*e)->size (), (*e)->buffer ());
+	}
+
+	_size = size;
+}
+
 void
 RTMidiBuffer::track (MidiStateTracker& mst, samplepos_t start, samplepos_t end)
 {
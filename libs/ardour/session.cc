@@ -240,6 +240,7 @@ Session::Session (AudioEngine &eng,
 	, _region_export (false)
 	, _export_preroll (0)
 	, _pre_export_mmc_enabled (false)
+	, _pre_export_block_size (0)
 	, _name (snapshot_name)
 	, _is_new (true)
 	, _send_qf_mtc (false)
@@ -253,6 +254,7 @@ Session::Session (AudioEngine &eng,
 	, _state_of_the_state (StateOfTheState (CannotSave | InitialConnecting | Loading))
 	, _save_queued (false)
 	, _save_queued_pending (false)
+	, _pending_save_thread (0)
 	, _last_roll_location (0)
 	, _last_roll_or_reversal_location (0)
 	, _last_record_location (0)
@@ -21,16 +21,23 @@
  */
 
 
+#include <algorithm>
+#include <limits>
+
 #include "pbd/error.h"
 #include <glibmm/threads.h>
 #include <glibmm/timer.h>
 
 #include <midi++/mmc.h>
 
+#include "ardour/audio_backend.h"
 #include "ardour/audioengine.h"
 #include "ardour/butler.h"
 #include "ardour/export_handler.h"
 #include "ardour/export_status.h"
+#include "ardour/io_plug.h"
+#include "ardour/plugin.h"
+#include "ardour/plugin_insert.h"
 #include "ardour/process_thread.h"
 #include "ardour/session.h"
 #include "ardour/track.h"
@@ -111,6 +118,86 @@ Session::pre_export ()
 	return 0;
 }
 
+bool
+Session::set_export_block_size (pframes_t bs)
+{
+	assert (!_engine.in_process_thread ());
+
+	if (bs == 0) {
+		if (_pre_export_block_size == 0) {
+			return false;
+		}
+		pframes_t const prev = _pre_export_block_size;
+		_pre_export_block_size = 0;
+		if (_engine.set_buffer_size (prev)) {
+			error << string_compose (_("Cannot restore engine buffer size to %1"), prev) << endmsg;
+			return false;
+		}
+		_engine.update_latencies ();
+		return true;
+	}
+
+	std::shared_ptr<AudioBackend> backend = _engine.current_backend ();
+
+	if (!_engine.running () || !backend || _pre_export_block_size != 0 || !backend->can_change_buffer_size_for_export ()) {
+		return false;
+	}
+
+	/* 8192 is the largest buffer-size that is used with any engine.
+	 * Plugins and the delaylines are re-configured by Session::set_block_size,
+	 * but not every plugin can process blocks larger than it was set up for.
+	 */
+	bs = std::min<pframes_t> (bs, 8192);
+	bs = std::min<pframes_t> (bs, max_plugin_block_size ());
+
+	if (bs <= _engine.samples_per_cycle ()) {
+		return false;
+	}
+
+	pframes_t const prev = _engine.samples_per_cycle ();
+
+	if (_engine.set_buffer_size (bs) || _engine.samples_per_cycle () != bs) {
+		/* the backend may have rejected the size, or settled on a different one */
+		if (_engine.samples_per_cycle () != prev) {
+			_engine.set_buffer_size (prev);
+		}
+		return false;
+	}
+
+	_pre_export_block_size = prev;
+
+	/* port latencies and the worst-case latency preroll depend on the buffer-size */
+	_engine.update_latencies ();
+	return true;
+}
+
+/** @return the largest block size that all plugins of the session support */
+pframes_t
+Session::max_plugin_block_size () const
+{
+	pframes_t bs = std::numeric_limits<pframes_t>::max ();
+
+	std::shared_ptr<RouteList const> rl = routes.reader ();
+	for (auto const& r : *rl) {
+		r->foreach_processor ([&bs] (std::weak_ptr<Processor> w) {
+			std::shared_ptr<PluginInsert> pi = std::dynamic_pointer_cast<PluginInsert> (w.lock ());
+			if (!pi) {
+				return;
+			}
+			for (uint32_t n = 0; n < pi->get_count (); ++n) {
+				bs = std::min (bs, pi->plugin (n)->max_block_size ());
+			}
+		});
+	}
+
+	std::shared_ptr<IOPlugList const> iop = _io_plugins.reader ();
+	for (auto const& p : *iop) {
+		bs = std::min (bs, p->plugin ()->max_block_size ());
+	}
+
+	return bs;
+}
+
 /** Called for each range that is being exported */
 int
 Session::start_audio_export (samplepos_t position, bool realtime, bool region_export)
@@ -451,6 +538,8 @@ Session::finalize_audio_export (TransportRequestSource trs)
 	_engine.freewheel (false);
 	export_freewheel_connection.disconnect();
 
+	set_export_block_size (0);
+
 	_mmc->enable_send (_pre_export_mmc_enabled);
 
 	/* maybe write CUE/TOC */
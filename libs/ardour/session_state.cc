@@ -677,9 +677,57 @@ Session::maybe_write_autosave()
 	}
 }
 
+static int
+write_state_file (XMLTree& tree, std::string const& tmp_path, std::string const& xml_path)
+{
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
+
+	if (!tree.write (tmp_path)) {
+		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
+	}
+
+	DEBUG_TRACE (DEBUG::SaveState, string_compose ("renaming state to '%1'\n", xml_path));
+
+	if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
+		error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
+				tmp_path, xml_path, g_strerror(errno)) << endmsg;
+		if (g_remove (tmp_path.c_str()) != 0) {
+			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
+					tmp_path, g_strerror (errno)) << endmsg;
+		}
+		return -1;
+	}
+
+	return 0;
+}
+
+static void
+write_pending_state (XMLTree* tree, std::string const& tmp_path, std::string const& xml_path)
+{
+	write_state_file (*tree, tmp_path, xml_path);
+	delete tree;
+}
+
+void
+Session::wait_for_pending_save ()
+{
+	if (_pending_save_thread) {
+		_pending_save_thread->join ();
+		delete _pending_save_thread;
+		_pending_save_thread = 0;
+	}
+}
+
 void
 Session::remove_pending_capture_state ()
 {
+	wait_for_pending_save ();
+
 	std::string pending_state_file_path(_session_dir->root_path());
 
 	pending_state_file_path = Glib::build_filename (pending_state_file_path, legalize_for_path (_current_snapshot_name) + pending_suffix);
@@ -768,7 +816,7 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	/* pending saves are for current snapshot only */
 	assert (!pending || ((snapshot_name.empty () || snapshot_name == _current_snapshot_name) && !template_only && !for_archive));
 
-	XMLTree tree;
+	std::unique_ptr<XMLTree> tree (new XMLTree);
 	std::string xml_path(_session_dir->root_path());
 
 	/* prevent concurrent saves from different threads */
@@ -779,6 +827,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 		lx.acquire ();
 	}
 
+	/* a previous pending save may still be writing the same tmp file */
+	wait_for_pending_save ();
+
 	if (!_writable || cannot_save()) {
 		return 1;
 	}
@@ -830,9 +881,9 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 
 	if (template_only) {
 		mark_as_clean = false;
-		tree.set_root (&get_template());
+		tree->set_root (&get_template());
 	} else {
-		tree.set_root (&state (false, fork_state, for_archive, only_used_assets));
+		tree->set_root (&state (false, fork_state, for_archive, only_used_assets));
 	}
 
 	if (snapshot_name.empty()) {
@@ -865,29 +916,22 @@ Session::save_state (string snapshot_name, bool pending, bool switch_to_snapshot
 	std::string tmp_path(_session_dir->root_path());
 	tmp_path = Glib::build_filename (tmp_path, legalize_for_path (snapshot_name) + temp_suffix);
 
-	DEBUG_TRACE (DEBUG::SaveState, string_compose ("writing state to '%1'\n", tmp_path));
-
-	if (!tree.write (tmp_path)) {
-		error << string_compose (_("state could not be saved to %1"), tmp_path) << endmsg;
-		if (g_remove (tmp_path.c_str()) != 0) {
-			error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-					tmp_path, g_strerror (errno)) << endmsg;
+	if (pending && !Profile->get_mixbus ()) {
+		/* pending saves are periodic safety backups or crash-recovery state
+		 * written when recording starts. Writing the file does not need
+		 * the session, so do it in the background. The next save,
+		 * removing pending state or destroying the session waits for it.
+		 */
+		XMLTree* t = tree.release ();
+		_pending_save_thread = PBD::Thread::create (boost::bind (&write_pending_state, t, tmp_path, xml_path), "SaveState");
+		if (!_pending_save_thread) {
+			write_pending_state (t, tmp_path, xml_path);
 		}
-		return -1;
-
-	} else {
-
-		DEBUG_TRACE (DEBUG::SaveState, string_compose ("renaming state to '%1'\n", xml_path));
+		return 0;
+	}
 
-		if (::g_rename (tmp_path.c_str(), xml_path.c_str()) != 0) {
-			error << string_compose (_("could not rename temporary session file %1 to %2 (%3)"),
-					tmp_path, xml_path, g_strerror(errno)) << endmsg;
-			if (g_remove (tmp_path.c_str()) != 0) {
-				error << string_compose(_("Could not remove temporary session file at path \"%1\" (%2)"),
-						tmp_path, g_strerror (errno)) << endmsg;
-			}
-			return -1;
-		}
+	if (write_state_file (*tree, tmp_path, xml_path)) {
+		return -1;
 	}
 
 	//Mixbus auto-backup mechanism
@@ -4037,6 +4081,9 @@ Session::cleanup_sources (CleanupReport& rep)
 				::g_rename (newpath.c_str (), _path.c_str ());
 				goto out;
 			}
+			for (uint32_t l = 1; l <= AudioSource::n_peak_levels; ++l) {
+				::g_unlink (AudioSource::peak_level_path (peakpath, l).c_str ());
+			}
 		}
 
 		rep.paths.push_back (*x);
@@ -771,6 +771,7 @@ SMFSource::load_model_unlocked (bool force_reload)
 
 	_model->end_write (Evoral::Sequence<Temporal::Beats>::ResolveStuckNotes, _length.beats());
 	_model->set_edited (false);
+	_model->contents_edited ();
 
 	free (buf);
 }
@@ -26,14 +26,21 @@
 #include "libardour-config.h"
 #endif
 
+#include <algorithm>
 #include <cstring>
 #include <cerrno>
 #include <climits>
 #include <cstdarg>
 #include <fcntl.h>
+#include <map>
+#include <vector>
 
 #include <sys/stat.h>
 
+#ifdef __linux__
+#include <linux/falloc.h>
+#endif
+
 #include <glib.h>
 #include "pbd/gstdio_compat.h"
 #include "pbd/progress.h"
@@ -47,7 +54,10 @@
 #include <glibmm/convert.h>
 #include <glibmm/fileutils.h>
 #include <glibmm/miscutils.h>
+#include <glibmm/threads.h>
 
+#include "ardour/mmap_audio_file.h"
+#include "ardour/rc_configuration.h"
 #include "ardour/runtime_functions.h"
 #include "ardour/sndfilesource.h"
 #include "ardour/sndfile_helpers.h"
@@ -67,11 +77,131 @@ const Source::Flag SndFileSource::default_writable_flags = Source::Flag (
 		Source::RemovableIfEmpty |
 		Source::CanRename );
 
+/** The most recently read block of interleaved data of a multi-channel
+ * file, shared by all SndFileSources of that file.
+ *
+ * The disk-reader reads the same range for each channel of a track in
+ * turn, so the first channel decodes a block and its siblings only
+ * de-interleave from it.
+ */
+class SndFileSource::SharedReadBlock
+{
+public:
+	static std::shared_ptr<SharedReadBlock> get (std::string const& path, uint32_t n_channels);
+
+	~SharedReadBlock ();
+
+	/** @return number of samples read, or -1 on error */
+	samplecnt_t read (SNDFILE*, Sample* dst, samplepos_t start, samplecnt_t cnt, int chn, float gain);
+
+private:
+	SharedReadBlock (std::string const& path, uint32_t n_channels)
+		: _path (path)
+		, _n_channels (n_channels)
+		, _start (0)
+		, _cnt (0)
+	{}
+
+	std::string          _path;
+	uint32_t             _n_channels;
+	Glib::Threads::Mutex _lock;
+	samplepos_t          _start;
+	samplecnt_t          _cnt;
+	std::vector<Sample>  _buf;
+
+	static Glib::Threads::Mutex                                      _registry_lock;
+	static std::map<std::string, std::weak_ptr<SharedReadBlock> > _registry;
+};
+
+Glib::Threads::Mutex                                                     SndFileSource::SharedReadBlock::_registry_lock;
+std::map<std::string, std::weak_ptr<SndFileSource::SharedReadBlock> > SndFileSource::SharedReadBlock::_registry;
+
+std::shared_ptr<SndFileSource::SharedReadBlock>
+SndFileSource::SharedReadBlock::get (std::string const& path, uint32_t n_channels)
+{
+	Glib::Threads::Mutex::Lock lm (_registry_lock);
+
+	std::shared_ptr<SharedReadBlock> rb = _registry[path].lock ();
+
+	if (!rb || rb->_n_channels != n_channels) {
+		rb.reset (new SharedReadBlock (path, n_channels));
+		_registry[path] = rb;
+	}
+
+	return rb;
+}
+
+SndFileSource::SharedReadBlock::~SharedReadBlock ()
+{
+	Glib::Threads::Mutex::Lock lm (_registry_lock);
+
+	std::map<std::string, std::weak_ptr<SharedReadBlock> >::iterator i = _registry.find (_path);
+
+	/* a new block may have been registered for the same file meanwhile */
+	if (i != _registry.end () && i->second.expired ()) {
+		_registry.erase (i);
+	}
+}
+
+samplecnt_t
+SndFileSource::SharedReadBlock::read (SNDFILE* sf, Sample* dst, samplepos_t start, samplecnt_t cnt, int chn, float gain)
+{
+	/* minimum block-size to decode, in sample-frames */
+	static const samplecnt_t min_block = 16384;
+
+	Glib::Threads::Mutex::Lock lm (_lock);
+
+	if (start < _start || start + cnt > _start + _cnt) {
+
+		samplecnt_t const want = std::max (cnt, min_block);
+
+		if (_buf.size () < (size_t) want * _n_channels) {
+			_buf.resize (want * _n_channels);
+		}
+
+		_cnt = 0;
+
+		if (sf_seek (sf, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
+			return -1;
+		}
+
+		sf_count_t const n = sf_readf_float (sf, &_buf[0], want);
+
+		if (n <= 0) {
+			return -1;
+		}
+
+		_start = start;
+		_cnt   = n;
+	}
+
+	samplecnt_t const nread = std::min (cnt, _start + _cnt - start);
+	Sample const*     ptr   = &_buf[(start - _start) * _n_channels + chn];
+
+	if (gain != 1.f) {
+		for (samplecnt_t n = 0; n < nread; ++n) {
+			dst[n] = *ptr * gain;
+			ptr += _n_channels;
+		}
+	} else {
+		for (samplecnt_t n = 0; n < nread; ++n) {
+			dst[n] = *ptr;
+			ptr += _n_channels;
+		}
+	}
+
+	return nread;
+}
+
 SndFileSource::SndFileSource (Session& s, const XMLNode& node)
 	: Source(s, node)
 	, AudioFileSource (s, node)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mmap (0)
+	, _capture_fd (-1)
+	, _preallocated (0)
+	, _writeback_pos (0)
 {
 	init_sndfile ();
 
@@ -92,6 +222,10 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn, Flag flag
 	, AudioFileSource (s, path, Flag (flags & ~(Writable|Removable|RemovableIfEmpty|RemoveAtDestroy)))
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mmap (0)
+	, _capture_fd (-1)
+	, _preallocated (0)
+	, _writeback_pos (0)
 {
 	_channel = chn;
 
@@ -114,6 +248,10 @@ SndFileSource::SndFileSource (Session& s, const string& path, const string& orig
 	, AudioFileSource (s, path, origin, flags, sfmt, hf)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mmap (0)
+	, _capture_fd (-1)
+	, _preallocated (0)
+	, _writeback_pos (0)
 {
 	int fmt = 0;
 
@@ -215,6 +353,10 @@ SndFileSource::SndFileSource (Session& s, const string& path, int chn)
 	, AudioFileSource (s, path, Flag (0))
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mmap (0)
+	, _capture_fd (-1)
+	, _preallocated (0)
+	, _writeback_pos (0)
 {
 	_channel = chn;
 
@@ -234,6 +376,10 @@ SndFileSource::SndFileSource (Session& s, const AudioFileSource& other, const st
 	, AudioFileSource (s, path, "", Flag ((other.flags () | default_writable_flags | NoPeakFile) & ~RF64_RIFF), /*unused*/ FormatFloat, /*unused*/ WAVE64)
 	, _sndfile (0)
 	, _broadcast_info (0)
+	, _mmap (0)
+	, _capture_fd (-1)
+	, _preallocated (0)
+	, _writeback_pos (0)
 {
 	if (other.readable_length_samples () == 0) {
 		throw failed_constructor();
@@ -346,6 +492,12 @@ SndFileSource::init_sndfile ()
 void
 SndFileSource::close ()
 {
+	delete _mmap;
+	_mmap = 0;
+	_read_block.reset ();
+	release_preallocation ();
+	_capture_fd = -1;
+
 	if (_sndfile) {
 		sf_close (_sndfile);
 		_sndfile = 0;
@@ -389,6 +541,12 @@ SndFileSource::open ()
 		return -1;
 	}
 
+	if (writable ()) {
+		_capture_fd    = fd;
+		_preallocated  = 0;
+		_writeback_pos = 0;
+	}
+
 	if (_channel >= _info.channels) {
 #ifndef HAVE_COREAUDIO
 		error << string_compose(_("SndFileSource: file only contains %1 channels; %2 is invalid as a channel number"), _info.channels, _channel) << endmsg;
@@ -486,6 +644,19 @@ SndFileSource::open ()
                 }
         }
 
+	if (!writable () && Config->get_mmap_audio_files ()) {
+		int const type = _info.format & SF_FORMAT_TYPEMASK;
+		if ((_info.format & SF_FORMAT_SUBMASK) == SF_FORMAT_FLOAT
+		    && (type == SF_FORMAT_WAV || type == SF_FORMAT_WAVEX || type == SF_FORMAT_RF64 || type == SF_FORMAT_CAF)) {
+			/* may fail (e.g. big-endian data), reads use libsndfile then */
+			_mmap = MMapAudioFile::open (_path, _info.channels, _info.frames);
+		}
+	}
+
+	if (!writable () && !_mmap && _info.channels > 1) {
+		_read_block = SharedReadBlock::get (_path, _info.channels);
+	}
+
 	return 0;
 }
 
@@ -548,6 +719,21 @@ SndFileSource::read_unlocked (Sample *dst, samplepos_t start, samplecnt_t cnt) c
 		memset (dst+file_cnt, 0, sizeof (Sample) * delta);
 	}
 
+	if (file_cnt && _mmap && _mmap->read (dst, start, file_cnt, _channel, _gain)) {
+		return file_cnt;
+	}
+
+	if (file_cnt && _read_block) {
+		samplecnt_t ret = _read_block->read (_sndfile, dst, start, file_cnt, _channel, _gain);
+		if (ret < 0) {
+			char errbuf[256];
+			sf_error_str (0, errbuf, sizeof (errbuf) - 1);
+			error << string_compose(_("SndFileSource: @ %1 could not read %2 within %3 (%4) (len = %5)"), start, file_cnt, _name, errbuf, _length) << endmsg;
+			return 0;
+		}
+		return ret;
+	}
+
 	if (file_cnt) {
 
 		if (sf_seek (_sndfile, (sf_count_t) start, SEEK_SET|SFM_READ) != (sf_count_t) start) {
@@ -632,6 +818,8 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 	assert (_length.time_domain() == Temporal::AudioTime);
 	update_length (timepos_t (_length.samples() + cnt));
 
+	capture_io_hints ();
+
 	if (_build_peakfiles) {
 		compute_and_write_peaks (data, sample_pos, cnt, true, true);
 	}
@@ -639,6 +827,65 @@ SndFileSource::nondestructive_write_unlocked (Sample *data, samplecnt_t cnt)
 	return cnt;
 }
 
+/* Capture files grow by small appends from the butler. On Linux
+ *  - allocate disk space ahead of the write position, in large chunks,
+ *    without changing the file-size. This reduces fragmentation
+ *    and file-system metadata updates for each write.
+ *  - start writeback of data that was written, so that the kernel does
+ *    not accumulate dirty pages, that are later flushed in bursts
+ *    which stall write() for all tracks.
+ */
+void
+SndFileSource::capture_io_hints ()
+{
+#ifdef __linux__
+	/* bytes of disk-space to preallocate at a time, and unit of writeback */
+	static const off_t prealloc_chunk  = 8 * 1048576;
+	static const off_t writeback_chunk = 1048576;
+
+	if (_capture_fd < 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat (_capture_fd, &st) != 0) {
+		return;
+	}
+
+	off_t const size = st.st_size;
+
+	if (Config->get_preallocate_capture_files () && size + prealloc_chunk / 2 > _preallocated) {
+		off_t const start = std::max (size, _preallocated);
+		if (fallocate (_capture_fd, FALLOC_FL_KEEP_SIZE, start, size + prealloc_chunk - start) == 0) {
+			_preallocated = size + prealloc_chunk;
+		}
+	}
+
+	if (size - _writeback_pos >= writeback_chunk) {
+		sync_file_range (_capture_fd, _writeback_pos, size - _writeback_pos, SYNC_FILE_RANGE_WRITE);
+		_writeback_pos = size;
+	}
+#endif
+}
+
+/** return space allocated beyond the end of the file */
+void
+SndFileSource::release_preallocation ()
+{
+#ifdef __linux__
+	if (_capture_fd < 0 || _preallocated == 0) {
+		return;
+	}
+
+	struct stat st;
+	if (fstat (_capture_fd, &st) == 0 && _preallocated > st.st_size) {
+		fallocate (_capture_fd, FALLOC_FL_PUNCH_HOLE | FALLOC_FL_KEEP_SIZE, st.st_size, _preallocated - st.st_size);
+	}
+
+	_preallocated = 0;
+#endif
+}
+
 int
 SndFileSource::update_header (samplepos_t when, struct tm& now, time_t tnow)
 {
@@ -668,6 +915,9 @@ SndFileSource::flush_header ()
 
 	int const r = sf_command (_sndfile, SFC_UPDATE_HEADER_NOW, 0, 0) != SF_TRUE;
 
+	/* headers are written when capture ends */
+	release_preallocation ();
+
 	return r;
 }
 
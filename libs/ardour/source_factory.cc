@@ -56,6 +56,7 @@ PBD::Signal1<void, std::shared_ptr<Source>> SourceFactory::SourceCreated;
 Glib::Threads::Cond                           SourceFactory::PeaksToBuild;
 Glib::Threads::Mutex                          SourceFactory::peak_building_lock;
 std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peaks;
+std::list<std::weak_ptr<AudioSource>>       SourceFactory::files_with_peak_levels;
 std::vector<PBD::Thread*>                     SourceFactory::peak_thread_pool;
 bool                                          SourceFactory::peak_thread_run = false;
 
@@ -71,7 +72,7 @@ peak_thread_work ()
 		SourceFactory::peak_building_lock.lock ();
 
 	wait:
-		if (SourceFactory::files_with_peaks.empty () && SourceFactory::peak_thread_run) {
+		if (SourceFactory::files_with_peaks.empty () && SourceFactory::files_with_peak_levels.empty () && SourceFactory::peak_thread_run) {
 			SourceFactory::PeaksToBuild.wait (SourceFactory::peak_building_lock);
 			(void) Temporal::TempoMap::fetch();
 		}
@@ -81,12 +82,16 @@ peak_thread_work ()
 			return;
 		}
 
-		if (SourceFactory::files_with_peaks.empty ()) {
+		/* peakfiles first, reduced peak levels are an optimization */
+		bool levels_only = SourceFactory::files_with_peaks.empty ();
+		std::list<std::weak_ptr<AudioSource>>& queue (levels_only ? SourceFactory::files_with_peak_levels : SourceFactory::files_with_peaks);
+
+		if (queue.empty ()) {
 			goto wait;
 		}
 
-		std::shared_ptr<AudioSource> as (SourceFactory::files_with_peaks.front ().lock ());
-		SourceFactory::files_with_peaks.pop_front ();
+		std::shared_ptr<AudioSource> as (queue.front ().lock ());
+		queue.pop_front ();
 		if (as) {
 			++active_threads;
 		}
@@ -96,7 +101,11 @@ peak_thread_work ()
 			continue;
 		}
 
-		as->setup_peakfile ();
+		if (levels_only) {
+			as->build_peak_levels ();
+		} else {
+			as->setup_peakfile ();
+		}
 		SourceFactory::peak_building_lock.lock ();
 		--active_threads;
 		SourceFactory::peak_building_lock.unlock ();
@@ -159,6 +168,14 @@ SourceFactory::setup_peakfile (std::shared_ptr<Source> s, bool async)
 	return 0;
 }
 
+void
+SourceFactory::build_peak_levels (std::shared_ptr<AudioSource> as)
+{
+	Glib::Threads::Mutex::Lock lm (peak_building_lock);
+	files_with_peak_levels.push_back (std::weak_ptr<AudioSource> (as));
+	PeaksToBuild.broadcast ();
+}
+
 std::shared_ptr<Source>
 SourceFactory::createSilent (Session& s, const XMLNode& node, samplecnt_t nframes, float sr)
 {
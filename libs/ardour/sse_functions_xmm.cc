@@ -114,5 +114,65 @@ x86_sse_find_peaks(const ARDOUR::Sample* buf, ARDOUR::pframes_t nframes, float *
 	_mm_store_ss(max, work);
 }
 
+/* Declick ramp: the gain approaches the target by a one-pole low-pass,
+ * g[n+1] = g[n] + coeff * (target - g[n]), so the distance to the target
+ * decays geometrically, g[n] = target + (initial - target) * (1 - coeff)^n.
+ * Each lane starts at its own power of (1 - coeff) and is advanced by
+ * (1 - coeff)^4 per iteration.
+ */
+float
+x86_sse_apply_gain_ramp_to_buffer (float* dst, uint32_t nframes, float initial, float target, float coeff)
+{
+	const float r = 1.f - coeff;
+	float       d = initial - target;
+
+	if (nframes >= 4) {
+		float  lanes[4];
+		double rk = 1.0;
+		for (int k = 0; k < 4; ++k) {
+			lanes[k] = d * rk;
+			rk *= r;
+		}
+
+		__m128       vd = _mm_loadu_ps (lanes);
+		const __m128 vr = _mm_set1_ps ((float)rk);
+		const __m128 vt = _mm_set1_ps (target);
+
+		while (nframes >= 4) {
+			__m128 x = _mm_loadu_ps (dst);
+			_mm_storeu_ps (dst, _mm_mul_ps (x, _mm_add_ps (vt, vd)));
+			vd = _mm_mul_ps (vd, vr);
+			dst += 4;
+			nframes -= 4;
+		}
+
+		_mm_store_ss (&d, vd);
+	}
+
+	while (nframes > 0) {
+		*dst++ *= target + d;
+		d *= r;
+		--nframes;
+	}
+
+	return target + d;
+}
 
+void
+x86_sse_apply_gain_vector_to_buffer (float* dst, float const* gain, uint32_t nframes)
+{
+	while (nframes >= 8) {
+		__m128 x0 = _mm_loadu_ps (dst + 0);
+		__m128 x1 = _mm_loadu_ps (dst + 4);
+		_mm_storeu_ps (dst + 0, _mm_mul_ps (x0, _mm_loadu_ps (gain + 0)));
+		_mm_storeu_ps (dst + 4, _mm_mul_ps (x1, _mm_loadu_ps (gain + 4)));
+		dst += 8;
+		gain += 8;
+		nframes -= 8;
+	}
 
+	while (nframes > 0) {
+		*dst++ *= *gain++;
+		--nframes;
+	}
+}
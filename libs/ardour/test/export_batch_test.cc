@@ -0,0 +1,277 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <cstring>
+#include <vector>
+
+#include <boost/scoped_array.hpp>
+#include <glibmm/miscutils.h>
+#include <glibmm/timer.h>
+#include <sndfile.h>
+
+#include "pbd/xml++.h"
+
+#include "ardour/audio_buffer.h"
+#include "ardour/audioengine.h"
+#include "ardour/export_channel.h"
+#include "ardour/export_channel_configuration.h"
+#include "ardour/export_filename.h"
+#include "ardour/export_format_specification.h"
+#include "ardour/export_handler.h"
+#include "ardour/export_status.h"
+#include "ardour/export_timespan.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/session.h"
+
+#include "export_batch_test.h"
+#include "test_util.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (ExportBatchTest);
+
+using namespace std;
+using namespace ARDOUR;
+
+/** Export channel that produces a ramp, every sample has
+ * the (scaled) number of samples that were read before it.
+ */
+class RampExportChannel : public ExportChannel
+{
+public:
+	RampExportChannel () : _buffer_size (0), _buf (0), _count (0) {}
+
+	void prepare_export (samplecnt_t max_samples, sampleoffset_t)
+	{
+		_buffer_size = max_samples;
+		_buffer.reset (new Sample[max_samples]);
+		_count = 0;
+	}
+
+	void read (Buffer const*& buf, samplecnt_t samples) const
+	{
+		assert (samples <= _buffer_size);
+		for (samplecnt_t i = 0; i < samples; ++i) {
+			_buffer[i] = value (_count + i);
+		}
+		_count += samples;
+		_buf.set_data (_buffer.get (), samples);
+		buf = &_buf;
+	}
+
+	/* exact as float for n < 2^24 */
+	static Sample value (samplecnt_t n) { return n / (float) (1 << 24); }
+
+	bool empty () const { return false; }
+
+	std::string state_node_name () const { return "RampExportChannel"; }
+	void get_state (XMLNode*) const {}
+	void set_state (XMLNode*, Session&) {}
+
+	bool operator< (ExportChannel const& other) const { return this < &other; }
+
+private:
+	samplecnt_t                 _buffer_size;
+	boost::scoped_array<Sample> _buffer;
+	mutable AudioBuffer         _buf;
+	mutable samplecnt_t         _count;
+};
+
+static vector<Sample>
+read_export (string const& path)
+{
+	SF_INFO info;
+	memset (&info, 0, sizeof (info));
+
+	SNDFILE* sf = sf_open (path.c_str (), SFM_READ, &info);
+	CPPUNIT_ASSERT (sf);
+	CPPUNIT_ASSERT_EQUAL (1, info.channels);
+
+	vector<Sample> data (info.frames);
+	CPPUNIT_ASSERT_EQUAL ((sf_count_t) data.size (), sf_readf_float (sf, &data[0], info.frames));
+	sf_close (sf);
+	return data;
+}
+
+static std::shared_ptr<ExportFormatSpecification>
+add_float_wav_format (std::shared_ptr<ExportHandler> handler)
+{
+	XMLTree tree;
+	tree.read_buffer (std::string (
+"<?xml version=\"1.0\" encoding=\"UTF-8\"?>"
+"<ExportFormatSpecification name=\"TEST-FLOAT-WAV\" id=\"4e8ab5c6-3a1f-4b8e-9e37-5d1c0b2f7a91\">"
+"  <Encoding id=\"F_WAV\" type=\"T_Sndfile\" extension=\"wav\" name=\"WAV\" has-sample-format=\"true\" channel-limit=\"256\"/>"
+"  <SampleRate rate=\"1\"/>"
+"  <SRCQuality quality=\"SRC_SincBest\"/>"
+"  <EncodingOptions>"
+"    <Option name=\"sample-format\" value=\"SF_Float\"/>"
+"    <Option name=\"dithering\" value=\"D_None\"/>"
+"    <Option name=\"tag-metadata\" value=\"false\"/>"
+"    <Option name=\"tag-support\" value=\"false\"/>"
+"    <Option name=\"broadcast-info\" value=\"false\"/>"
+"  </EncodingOptions>"
+"  <Processing>"
+"    <Normalize enabled=\"false\" target=\"0\"/>"
+"  </Processing>"
+"</ExportFormatSpecification>"
+	).c_str ());
+
+	std::shared_ptr<ExportFormatSpecification> fmt = handler->add_format (*tree.root ());
+	fmt->set_soundcloud_upload (false);
+
+	return fmt;
+}
+
+static void
+wait_for_export (Session* session)
+{
+	std::shared_ptr<ExportStatus> status = session->get_export_status ();
+
+	for (int timeout = 600; status->running () && timeout > 0; --timeout) {
+		Glib::usleep (100000);
+	}
+
+	CPPUNIT_ASSERT (!status->running ());
+	CPPUNIT_ASSERT (!status->aborted ());
+	status->finish (TRS_UI);
+}
+
+/** Export two overlapping timespans in a single pass, and check
+ * that each file starts and ends exactly at its timespan.
+ */
+void
+ExportBatchTest::overlappingTimespansTest ()
+{
+	CPPUNIT_ASSERT (Config->get_export_batch_timespans ());
+
+	std::shared_ptr<ExportHandler> handler = _session->get_export_handler ();
+	samplecnt_t const sr = _session->nominal_sample_rate ();
+
+	std::shared_ptr<ExportFormatSpecification> fmt = add_float_wav_format (handler);
+
+	std::shared_ptr<ExportChannelConfiguration> ccp = handler->add_channel_config ();
+	ccp->register_channel (ExportChannelPtr (new RampExportChannel ()));
+
+	string const dir = new_test_output_dir ("export_batch");
+
+	/* neither range is aligned to the engine's buffer-size */
+	samplepos_t const start[2] = { sr + 17, 2 * sr + 123 };
+	samplepos_t const end[2]   = { 3 * sr + 5, 4 * sr + 301 };
+	string const      name[2]  = { "first", "second" };
+
+	vector<ExportTimespanPtr> spans;
+
+	for (int i = 0; i < 2; ++i) {
+		ExportTimespanPtr tsp = handler->add_timespan ();
+		ExportFilenamePtr fnp = handler->add_filename ();
+		BroadcastInfoPtr  b;
+
+		tsp->set_range (start[i], end[i]);
+		tsp->set_name (name[i]);
+
+		fnp->set_folder (dir);
+		fnp->set_timespan (tsp);
+		fnp->include_label = false;
+
+		handler->add_export_config (tsp, ccp, fmt, fnp, b);
+		spans.push_back (tsp);
+	}
+
+	CPPUNIT_ASSERT_EQUAL (0, handler->do_export ());
+
+	wait_for_export (_session);
+
+	vector<Sample> first  = read_export (Glib::build_filename (dir, name[0] + ".wav"));
+	vector<Sample> second = read_export (Glib::build_filename (dir, name[1] + ".wav"));
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) spans[0]->get_length (), first.size ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) spans[1]->get_length (), second.size ());
+
+	/* The ramp restarts with every pass (prepare_export), so the second
+	 * file only continues the ramp of the first if both were rendered
+	 * in the same pass. Pre-roll shifts both alike, hence positions are
+	 * checked relative to the start of the first range.
+	 */
+	samplecnt_t const origin = (samplecnt_t) (first[0] * (1 << 24));
+
+	for (size_t n = 0; n < first.size (); ++n) {
+		CPPUNIT_ASSERT_EQUAL (RampExportChannel::value (origin + n), first[n]);
+	}
+
+	for (size_t n = 0; n < second.size (); ++n) {
+		CPPUNIT_ASSERT_EQUAL (RampExportChannel::value (origin + start[1] - start[0] + n), second[n]);
+	}
+}
+
+/** Export with a larger block size than the engine's buffer-size.
+ * The latency preroll and the alignment of the range are then computed
+ * for the export block size, the file must still match the range exactly.
+ */
+void
+ExportBatchTest::largeBlockTest ()
+{
+	AudioEngine*    engine = AudioEngine::instance ();
+	pframes_t const bs     = engine->samples_per_cycle ();
+	uint32_t const  ebs    = Config->get_export_block_size ();
+
+	CPPUNIT_ASSERT (bs < 4096);
+	Config->set_export_block_size (4096);
+
+	std::shared_ptr<ExportHandler> handler = _session->get_export_handler ();
+	samplecnt_t const sr = _session->nominal_sample_rate ();
+
+	std::shared_ptr<ExportFormatSpecification> fmt = add_float_wav_format (handler);
+
+	std::shared_ptr<ExportChannelConfiguration> ccp = handler->add_channel_config ();
+	ccp->register_channel (ExportChannelPtr (new RampExportChannel ()));
+
+	string const dir = new_test_output_dir ("export_large_block");
+
+	ExportTimespanPtr tsp = handler->add_timespan ();
+	ExportFilenamePtr fnp = handler->add_filename ();
+	BroadcastInfoPtr  b;
+
+	tsp->set_range (sr + 17, 3 * sr + 301);
+	tsp->set_name ("large");
+
+	fnp->set_folder (dir);
+	fnp->set_timespan (tsp);
+	fnp->include_label = false;
+
+	handler->add_export_config (tsp, ccp, fmt, fnp, b);
+
+	CPPUNIT_ASSERT_EQUAL (0, handler->do_export ());
+
+	/* the Dummy backend allows to change the buffer-size for export */
+	CPPUNIT_ASSERT_EQUAL ((pframes_t) 4096, engine->samples_per_cycle ());
+	CPPUNIT_ASSERT_EQUAL ((samplecnt_t) 0, _session->worst_latency_preroll_buffer_size_ceil () % 4096);
+
+	wait_for_export (_session);
+
+	Config->set_export_block_size (ebs);
+
+	CPPUNIT_ASSERT_EQUAL (bs, engine->samples_per_cycle ());
+
+	vector<Sample> data = read_export (Glib::build_filename (dir, "large.wav"));
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) tsp->get_length (), data.size ());
+
+	samplecnt_t const origin = (samplecnt_t) (data[0] * (1 << 24));
+
+	for (size_t n = 0; n < data.size (); ++n) {
+		CPPUNIT_ASSERT_EQUAL (RampExportChannel::value (origin + n), data[n]);
+	}
+}
@@ -83,6 +83,50 @@ FPUTest::run (size_t align_max, float const max_diff)
 			CPPUNIT_ASSERT_MESSAGE (string_compose ("Find peaks not aligned off: %1 cnt: %2", off, cnt), fabsf (pk_test - pk_comp) < 2e-6 && fabsf (pk_test_max - pk_comp_max) < 2e-6);
 		}
 	}
+
+	gain_ramp (align_max);
+}
+
+void
+FPUTest::gain_ramp (size_t align_max)
+{
+	/* 25 Hz LPF at 48kHz, see Amp::apply_gain */
+	const float coeff = 156.825f / 48000.f;
+
+	for (size_t i = 0; i < _size; ++i) {
+		_test1[i] = _comp1[i] = 3.0 / (i + 1.0);
+		_test2[i] = _comp2[i] = 0.5 + 0.5 * sinf (i * 0.01);
+	}
+
+	/* The SIMD ramp is computed in closed form, while the reference
+	 * accumulates the low-pass per sample. Rounding differs by a few
+	 * ulp of the gain per step; with samples up to 3.0 here, and the
+	 * loop below applying ramps repeatedly to the same data, results
+	 * agree within 1e-5 (not bit-exact).
+	 */
+	const float ramp_tolerance = 1e-5;
+
+	float g_test = apply_gain_ramp_to_buffer (_test1, _size, 0.2, 1.1, coeff);
+	float g_comp = default_apply_gain_ramp_to_buffer (_comp1, _size, 0.2, 1.1, coeff);
+	compare ("Gain Ramp", _size, ramp_tolerance);
+	CPPUNIT_ASSERT_MESSAGE ("Gain Ramp target", fabsf (g_test - g_comp) < ramp_tolerance);
+
+	apply_gain_vector_to_buffer (_test1, _test2, _size);
+	default_apply_gain_vector_to_buffer (_comp1, _comp2, _size);
+	compare ("Gain Vector", _size);
+
+	for (size_t off = 0; off < align_max; ++off) {
+		for (size_t cnt = 1; cnt < align_max; ++cnt) {
+			g_test = apply_gain_ramp_to_buffer (&_test1[off], cnt, 1.0, 0.0, coeff);
+			g_comp = default_apply_gain_ramp_to_buffer (&_comp1[off], cnt, 1.0, 0.0, coeff);
+			compare (string_compose ("Gain Ramp not aligned off: %1 cnt: %2", off, cnt), cnt, ramp_tolerance);
+			CPPUNIT_ASSERT_MESSAGE (string_compose ("Gain Ramp target not aligned off: %1 cnt: %2", off, cnt), fabsf (g_test - g_comp) < ramp_tolerance);
+
+			apply_gain_vector_to_buffer (&_test1[off], &_test2[off], cnt);
+			default_apply_gain_vector_to_buffer (&_comp1[off], &_comp2[off], cnt);
+			compare (string_compose ("Gain Vector not aligned off: %1 cnt: %2", off, cnt), cnt, 1e-5);
+		}
+	}
 }
 
 void
@@ -123,6 +167,9 @@ FPUTest::avxFmaTest ()
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
 
+	apply_gain_ramp_to_buffer   = x86_sse_avx_apply_gain_ramp_to_buffer;
+	apply_gain_vector_to_buffer = x86_sse_avx_apply_gain_vector_to_buffer;
+
 	run (align_max, FLT_EPSILON);
 }
 
@@ -150,6 +197,9 @@ FPUTest::avxTest ()
 	mix_buffers_no_gain   = x86_sse_avx_mix_buffers_no_gain;
 	copy_vector           = x86_sse_avx_copy_vector;
 
+	apply_gain_ramp_to_buffer   = x86_sse_avx_apply_gain_ramp_to_buffer;
+	apply_gain_vector_to_buffer = x86_sse_avx_apply_gain_vector_to_buffer;
+
 	run (align_max);
 }
 
@@ -177,6 +227,9 @@ FPUTest::avx512fTest ()
 	mix_buffers_no_gain   = x86_avx512f_mix_buffers_no_gain;
 	copy_vector           = x86_avx512f_copy_vector;
 
+	apply_gain_ramp_to_buffer   = x86_avx512f_apply_gain_ramp_to_buffer;
+	apply_gain_vector_to_buffer = x86_avx512f_apply_gain_vector_to_buffer;
+
 	run (align_max, FLT_EPSILON);
 }
 
@@ -204,6 +257,9 @@ FPUTest::sseTest ()
 	mix_buffers_no_gain   = x86_sse_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
 
+	apply_gain_ramp_to_buffer   = x86_sse_apply_gain_ramp_to_buffer;
+	apply_gain_vector_to_buffer = x86_sse_apply_gain_vector_to_buffer;
+
 	run (align_max);
 }
 
@@ -228,6 +284,9 @@ FPUTest::neonTest ()
 	mix_buffers_no_gain   = arm_neon_mix_buffers_no_gain;
 	copy_vector           = arm_neon_copy_vector;
 
+	apply_gain_ramp_to_buffer   = arm_neon_apply_gain_ramp_to_buffer;
+	apply_gain_vector_to_buffer = arm_neon_apply_gain_vector_to_buffer;
+
 	run (128);
 }
 
@@ -252,6 +311,9 @@ FPUTest::veclibTest ()
 	mix_buffers_no_gain   = veclib_mix_buffers_no_gain;
 	copy_vector           = default_copy_vector;
 
+	apply_gain_ramp_to_buffer   = default_apply_gain_ramp_to_buffer;
+	apply_gain_vector_to_buffer = veclib_apply_gain_vector_to_buffer;
+
 #ifdef  __aarch64__
 	run (16, FLT_EPSILON);
 #else
@@ -40,6 +40,7 @@ public:
 private:
 	void run (size_t, float const max_diff = 0);
 	void compare (std::string, size_t, float const max_diff = 0);
+	void gain_ramp (size_t);
 
 	ARDOUR::compute_peak_t          compute_peak;
 	ARDOUR::find_peaks_t            find_peaks;
@@ -48,6 +49,9 @@ private:
 	ARDOUR::mix_buffers_no_gain_t   mix_buffers_no_gain;
 	ARDOUR::copy_vector_t           copy_vector;
 
+	ARDOUR::apply_gain_ramp_to_buffer_t   apply_gain_ramp_to_buffer;
+	ARDOUR::apply_gain_vector_to_buffer_t apply_gain_vector_to_buffer;
+
 	size_t _size;
 
 	float* _test1;
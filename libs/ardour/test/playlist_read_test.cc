@@ -18,6 +18,7 @@
 
 #include "ardour/playlist.h"
 #include "ardour/region.h"
+#include "ardour/region_factory.h"
 #include "ardour/audioplaylist.h"
 #include "ardour/audioregion.h"
 #include "ardour/session.h"
@@ -213,6 +214,59 @@ PlaylistReadTest::miscReadTest ()
 	_audio_playlist->read (_buf, _mbuf, _gbuf, 53, 54, 0);
 }
 
+/* Check that indexed region lookup agrees with a linear scan of the
+ * region list, for playlists below and above the indexing threshold.
+ */
+void
+PlaylistReadTest::regionIndexTest ()
+{
+	int const sizes[] = { 16, 256, 1024, 5000 };
+
+	for (size_t s = 0; s < sizeof (sizes) / sizeof (sizes[0]); ++s) {
+
+		_audio_playlist->clear ();
+		_audio_playlist->freeze ();
+
+		PBD::PropertyList plist;
+		plist.add (Properties::start, timepos_t (0));
+		plist.add (Properties::length, 100);
+
+		/* overlapping takes, as left behind by comping */
+		for (int i = 0; i < sizes[s]; ++i) {
+			std::shared_ptr<Region> r = RegionFactory::create (_source, plist);
+			_audio_playlist->add_region (r, timepos_t (samplepos_t (i * 64)));
+		}
+
+		_audio_playlist->thaw ();
+
+		samplepos_t const extent = sizes[s] * 64 + 100;
+		std::shared_ptr<RegionList> all = _audio_playlist->region_list ();
+
+		for (samplepos_t pos = 0; pos < extent; pos += 97) {
+			timepos_t const start (pos);
+			timepos_t const end (pos + 256);
+
+			std::shared_ptr<RegionList> touched = _audio_playlist->regions_touched (start, end);
+			RegionList expected;
+			for (auto const & r : *all) {
+				if (r->coverage (start, end) != Temporal::OverlapNone) {
+					expected.push_back (r);
+				}
+			}
+			CPPUNIT_ASSERT (*touched == expected);
+
+			uint32_t n = 0;
+			for (auto const & r : *all) {
+				if (r->covers (start)) {
+					++n;
+				}
+			}
+			CPPUNIT_ASSERT_EQUAL (n, _audio_playlist->count_regions_at (start));
+			CPPUNIT_ASSERT_EQUAL ((size_t) n, _audio_playlist->regions_at (start)->size ());
+		}
+	}
+}
+
 void
 PlaylistReadTest::check_staircase (Sample* b, int offset, int N)
 {
@@ -0,0 +1,78 @@
+#include <iostream>
+#include "pbd/malign.h"
+#include "pbd/timing.h"
+#include "ardour/ardour.h"
+#include "ardour/mix.h"
+#include "ardour/runtime_functions.h"
+
+using namespace std;
+using namespace PBD;
+using namespace ARDOUR;
+
+static const char* localedir = LOCALEDIR;
+
+/* Compare the generic gain ramp and gain curve with the
+ * hardware optimized routines selected by ARDOUR::init ().
+ */
+int
+main (int argc, char* argv[])
+{
+	ARDOUR::init (true, localedir);
+
+	const pframes_t nframes = 1024;
+	const int       cycles  = 20000;
+	const float     coeff   = 156.825f / 48000.f; // 25 Hz LPF, see Amp::apply_gain
+
+	Sample* buf;
+	gain_t* gab;
+	cache_aligned_malloc ((void**) &buf, sizeof (Sample) * nframes);
+	cache_aligned_malloc ((void**) &gab, sizeof (gain_t) * nframes);
+
+	for (pframes_t i = 0; i < nframes; ++i) {
+		buf[i] = 1.f;
+		gab[i] = 1.f;
+	}
+
+	TimingData t_default;
+	TimingData t_runtime;
+
+	for (int i = 0; i < cycles; ++i) {
+		/* keep values normal, the ramp does not settle */
+		for (pframes_t n = 0; n < nframes; ++n) {
+			buf[n] = 1.f;
+		}
+
+		t_default.start_timing ();
+		default_apply_gain_ramp_to_buffer (buf, nframes, 0.f, 1.f, coeff);
+		t_default.add_elapsed ();
+
+		t_runtime.start_timing ();
+		apply_gain_ramp_to_buffer (buf, nframes, 0.f, 1.f, coeff);
+		t_runtime.add_elapsed ();
+	}
+
+	cout << "Gain ramp, generic:   " << t_default.summary ();
+	cout << "Gain ramp, optimized: " << t_runtime.summary ();
+
+	t_default.reset ();
+	t_runtime.reset ();
+
+	for (int i = 0; i < cycles; ++i) {
+		t_default.start_timing ();
+		default_apply_gain_vector_to_buffer (buf, gab, nframes);
+		t_default.add_elapsed ();
+
+		t_runtime.start_timing ();
+		apply_gain_vector_to_buffer (buf, gab, nframes);
+		t_runtime.add_elapsed ();
+	}
+
+	cout << "Gain curve, generic:   " << t_default.summary ();
+	cout << "Gain curve, optimized: " << t_runtime.summary ();
+
+	cache_aligned_free (buf);
+	cache_aligned_free (gab);
+
+	ARDOUR::cleanup ();
+	return 0;
+}
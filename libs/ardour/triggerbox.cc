@@ -1253,6 +1253,7 @@ Trigger::start_and_roll_to (samplepos_t start_pos, samplepos_t end_position, Tri
 AudioTrigger::AudioTrigger (uint32_t n, TriggerBox& b)
 	: Trigger (n, b)
 	, _stretcher (0)
+	, _stream (0)
 	, _start_offset (0)
 	, read_index (0)
 	, last_readable_sample (0)
@@ -1432,6 +1433,14 @@ void
 AudioTrigger::start_and_roll_to (samplepos_t start_pos, samplepos_t end_position, uint32_t cnt)
 {
 	Trigger::start_and_roll_to<AudioTrigger> (start_pos, end_position, *this, &AudioTrigger::audio_run<false>, cnt);
+
+	if (_stream) {
+		/* audio_run<false> does not read the data, start streaming at the new position */
+		_stream->seek (read_index);
+		if (_stream->want_refill ()) {
+			TriggerBox::worker->request_refill ();
+		}
+	}
 }
 
 timepos_t
@@ -1680,7 +1689,8 @@ AudioTrigger::estimate_tempo ()
 
 			breakfastquay::MiniBPM mbpm (_box.session().sample_rate());
 
-			_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], data.length);
+			/* for streamed clips only the head is analyzed */
+			_estimated_tempo = mbpm.estimateTempoOfSamples (data[0], data.resident);
 
 			//cerr << name() << "MiniBPM Estimated: " << _estimated_tempo << " bpm from " << (double) data.length / _box.session().sample_rate() << " seconds\n";
 		}
@@ -1756,6 +1766,8 @@ AudioTrigger::io_change ()
 
 /* This exists so that we can play with the value easily. Currently, 1024 seems as good as any */
 static const samplecnt_t rb_blocksize = 1024;
+/* samples per channel that are read from a clip stream at once, >= rb_blocksize */
+static const samplecnt_t stream_chunk = 8192;
 
 void
 AudioTrigger::reset_stretcher ()
@@ -1798,10 +1810,19 @@ AudioTrigger::setup_stretcher ()
 void
 AudioTrigger::drop_data ()
 {
-	for (auto& d : data) {
-		delete [] d;
+	if (_stream) {
+		/* the worker deletes the stream */
+		TriggerBox::worker->remove_stream (_stream);
+		_stream = 0;
 	}
+	for (auto& b : _stream_buf) {
+		delete [] b;
+	}
+	_stream_buf.clear ();
+	_clip_ptr.clear ();
+
 	data.clear ();
+	data.buffers.clear ();
 }
 
 int
@@ -1809,15 +1830,51 @@ AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
 {
 	const uint32_t nchans = ar->n_channels();
 
-	data.length = ar->length_samples();
 	drop_data ();
 
+	data.length   = ar->length_samples();
+	data.resident = data.length;
+
+	/* Long clips are streamed from disk, only the head is kept in
+	 * memory, so that the clip can be launched without delay.
+	 */
+	const samplecnt_t sr        = _box.session().sample_rate();
+	const samplecnt_t threshold = Config->get_clip_streaming_threshold() * sr;
+	const samplecnt_t bufsize   = std::max<samplecnt_t> (Config->get_clip_streaming_buffer() * sr, stream_chunk * 4);
+
+	if (TriggerBox::worker && threshold > 0 && data.length > threshold && data.length > bufsize) {
+		data.resident = bufsize;
+	}
+
+	ClipSampleStore& store (ClipSampleStore::instance ());
+
 	try {
 		for (uint32_t n = 0; n < nchans; ++n) {
-			data.push_back (new Sample[data.length]);
-			ar->read (data[n], 0, data.length, n);
+			ClipSampleStore::BufferPtr buf = store.get (ar->audio_source (n), ar->start_sample (), data.resident);
+			if (!buf) {
+				drop_data ();
+				return -1;
+			}
+			data.buffers.push_back (buf);
+			data.push_back (buf->data ());
+		}
+
+		if (data.resident < data.length) {
+			_stream = new ClipStream (ar, data.resident, bufsize);
+			_stream->refill ();
+			_stream->want_refill ();
+
+			for (uint32_t n = 0; n < nchans; ++n) {
+				_stream_buf.push_back (new Sample[stream_chunk]);
+			}
+
+			TriggerBox::worker->add_stream (_stream);
+
+			DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 streaming, %2 of %3 samples resident\n", ar->name(), data.resident, data.length));
 		}
 
+		_clip_ptr.resize (nchans);
+
 		set_name (ar->name());
 
 	} catch (...) {
@@ -1828,6 +1885,52 @@ AudioTrigger::load_data (std::shared_ptr<AudioRegion> ar)
 	return 0;
 }
 
+Sample* const*
+AudioTrigger::clip_data (samplepos_t pos, samplecnt_t& cnt, bool from_stream)
+{
+	/* Return pointers to @param cnt samples of every channel starting at
+	 * @param pos. Data that is not resident is copied to _stream_buf,
+	 * @param cnt is reduced if needed. Unless @param from_stream is set,
+	 * data that is not resident is silent and the stream is not touched.
+	 */
+	const uint32_t nchans = data.size();
+
+	if (_stream) {
+		cnt = std::min (cnt, stream_chunk);
+	}
+
+	if (!_stream || pos + cnt <= data.resident) {
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			_clip_ptr[chn] = data[chn] + pos;
+		}
+		return &_clip_ptr[0];
+	}
+
+	samplecnt_t head = 0;
+
+	if (pos < data.resident) {
+		head = data.resident - pos;
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			memcpy (_stream_buf[chn], data[chn] + pos, sizeof (Sample) * head);
+		}
+	}
+
+	if (!from_stream) {
+		for (uint32_t chn = 0; chn < nchans; ++chn) {
+			memset (_stream_buf[chn] + head, 0, sizeof (Sample) * (cnt - head));
+		}
+		return &_stream_buf[0];
+	}
+
+	_stream->read (&_stream_buf[0], head, pos + head, cnt - head);
+
+	if (_stream->want_refill ()) {
+		TriggerBox::worker->request_refill ();
+	}
+
+	return &_stream_buf[0];
+}
+
 void
 AudioTrigger::retrigger ()
 {
@@ -1840,6 +1943,13 @@ AudioTrigger::retrigger ()
 	retrieved = 0;
 	_legato_offset = 0; /* used one time only */
 
+	if (_stream) {
+		_stream->seek (read_index);
+		if (_stream->want_refill ()) {
+			TriggerBox::worker->request_refill ();
+		}
+	}
+
 	DEBUG_TRACE (DEBUG::Triggers, string_compose ("%1 retriggered to %2\n", _index, read_index));
 }
 
@@ -1961,6 +2071,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 		pframes_t to_stretcher;
 		pframes_t from_stretcher;
+		Sample* const* clip_src = 0;
 
 		if (do_stretch) {
 
@@ -1978,10 +2089,18 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 					 * the end of the region
 					 */
 
+					/* Outside of process context (start_and_roll_to) the output
+					 * is discarded, and the stream is re-positioned afterwards.
+					 * Do not consume it here.
+					 */
+					samplecnt_t to_read = to_stretcher;
+					Sample* const* src = clip_data (read_index, to_read, in_process_context);
+					assert (to_read == to_stretcher);
+
 					std::vector<Sample*> in(nchans);
 
 					for (uint32_t chn = 0; chn < nchans; ++chn) {
-						in[chn] = data[chn] + read_index;
+						in[chn] = src[chn];
 					}
 
 					/* Note: RubberBandStretcher's process() and retrieve() API's accepts Sample**
@@ -2056,7 +2175,11 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 		} else {
 			/* no stretch */
 			assert (last_readable_sample >= read_index);
-			from_stretcher = std::min<samplecnt_t> (nframes, last_readable_sample - read_index);
+			samplecnt_t to_read = std::min<samplecnt_t> (nframes, last_readable_sample - read_index);
+			if (in_process_context) {
+				clip_src = clip_data (read_index, to_read);
+			}
+			from_stretcher = to_read;
 			// cerr << "FS#3 from lrs " << last_readable_sample <<  " - " << read_index << " = " << from_stretcher << endl;
 
 		}
@@ -2071,7 +2194,7 @@ AudioTrigger::audio_run (BufferSet& bufs, samplepos_t start_sample, samplepos_t
 
 				uint32_t channel = chn %  data.size();
 				AudioBuffer& buf (bufs.get_audio (chn));
-				Sample* src = do_stretch ? bufp[channel] : (data[channel] + read_index);
+				Sample* src = do_stretch ? bufp[channel] : clip_src[channel];
 
 				gain_t gain;
 
@@ -4845,6 +4968,7 @@ MultiAllocSingleReleasePool* TriggerBoxThread::Request::pool = 0;
 TriggerBoxThread::TriggerBoxThread ()
 	: requests (1024)
 	, _xthread (true)
+	, _refilling (false)
 {
 	if (pthread_create_and_store ("triggerbox thread", &thread, _thread_work, this)) {
 		error << _("Session: could not create triggerbox thread") << endmsg;
@@ -4884,6 +5008,11 @@ TriggerBoxThread::thread_work ()
 				abort(); /*NOTREACHED*/
 			}
 
+			if (msg == (char) Refill) {
+				refill_streams ();
+				continue;
+			}
+
 			Temporal::TempoMap::fetch ();
 
 			Request* req;
@@ -4963,6 +5092,71 @@ TriggerBoxThread::request_delete_trigger (Trigger* t)
 	queue_request (req);
 }
 
+void
+TriggerBoxThread::add_stream (ClipStream* s)
+{
+	Glib::Threads::Mutex::Lock lm (_stream_lock);
+	_streams.insert (s);
+}
+
+void
+TriggerBoxThread::remove_stream (ClipStream* s)
+{
+	Glib::Threads::Mutex::Lock lm (_stream_lock);
+	_streams.erase (s);
+	if (_refilling) {
+		/* the worker may be reading into it right now */
+		_dead_streams.push_back (s);
+		return;
+	}
+	lm.release ();
+	delete s;
+}
+
+void
+TriggerBoxThread::request_refill ()
+{
+	/* called from the process thread, no payload is needed */
+	char c = Refill;
+	_xthread.deliver (c);
+}
+
+void
+TriggerBoxThread::refill_streams ()
+{
+	/* Do not hold the lock during disk I/O, triggers must be able
+	 * to add and remove streams meanwhile.
+	 */
+	std::vector<ClipStream*> streams;
+	{
+		Glib::Threads::Mutex::Lock lm (_stream_lock);
+		streams.assign (_streams.begin (), _streams.end ());
+		_refilling = true;
+	}
+
+	for (auto& s : streams) {
+		{
+			Glib::Threads::Mutex::Lock lm (_stream_lock);
+			if (_streams.find (s) == _streams.end ()) {
+				/* removed since, deleted below */
+				continue;
+			}
+		}
+		s->refill ();
+	}
+
+	std::vector<ClipStream*> dead;
+	{
+		Glib::Threads::Mutex::Lock lm (_stream_lock);
+		_refilling = false;
+		dead.swap (_dead_streams);
+	}
+
+	for (auto& s : dead) {
+		delete s;
+	}
+}
+
 void
 TriggerBoxThread::delete_trigger (Trigger* t)
 {
@@ -48,6 +48,7 @@
 #include "pbd/localtime_r.h"
 
 #include "ardour/filesystem_paths.h"
+#include "ardour/plugin_cache_stamp.h"
 #include "ardour/linux_vst_support.h"
 #include "ardour/mac_vst_support.h"
 #include "ardour/vst_types.h"
@@ -605,6 +606,13 @@ ARDOUR::vst2_valid_cache_file (std::string const& path, bool verbose, bool* is_n
 	if (g_stat (path.c_str(), &sb_vst) == 0 && g_stat (cache_file.c_str (), &sb_v2i) == 0) {
 		if (sb_vst.st_mtime < sb_v2i.st_mtime) {
 			/* plugin is older than cache file */
+			XMLTree tree;
+			if (tree.read (cache_file) && !plugin_module_stamp_matches (tree.root(), sb_vst)) {
+				if (verbose) {
+					PBD::info << "Plugin size or timestamp changed." << endmsg;
+				}
+				return "";
+			}
 			if (verbose) {
 				PBD::info << "Cache file is up-to-date." << endmsg;
 			}
@@ -648,6 +656,8 @@ touch_cachefile (std::string const& path, std::string const& cache_file, bool ve
 static bool
 vst2_save_cache_file (std::string const& path, XMLNode* root, bool verbose)
 {
+	set_plugin_module_stamp (root, path);
+
 	string const cache_file = ARDOUR::vst2_cache_file (path);
 
 	XMLTree tree;
@@ -40,6 +40,7 @@
 #include "pbd/localtime_r.h"
 
 #include "ardour/filesystem_paths.h"
+#include "ardour/plugin_cache_stamp.h"
 #include "ardour/vst3_module.h"
 #include "ardour/vst3_host.h"
 #include "ardour/vst3_scan.h"
@@ -414,6 +415,12 @@ ARDOUR::vst3_valid_cache_file (std::string const& module_path, bool verbose, boo
 				}
 				return "";
 			}
+			if (!plugin_module_stamp_matches (tree.root(), sb_vst)) {
+				if (verbose) {
+					PBD::info << "Module size or timestamp changed." << endmsg;
+				}
+				return "";
+			}
 			if (verbose) {
 				PBD::info << "Cache file is valid and up-to-date." << endmsg;
 			}
@@ -457,6 +464,8 @@ touch_cachefile (std::string const& module_path, std::string const& cache_file,
 static bool
 vst3_save_cache_file (std::string const& module_path, XMLNode* root, bool verbose)
 {
+	set_plugin_module_stamp (root, module_path);
+
 	string const cache_file = ARDOUR::vst3_cache_file (module_path);
 
 	XMLTree tree;
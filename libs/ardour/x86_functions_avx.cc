@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include "ardour/mix.h"
+
+#include <immintrin.h>
+#include <xmmintrin.h>
+
+#ifndef __AVX__
+#error "__AVX__ must be enabled for this module to work"
+#endif
+
+/**
+ * @brief x86-64 AVX optimized routine for a declicking gain ramp.
+ *
+ * The gain approaches @p target by a one-pole low-pass per sample, the
+ * distance to the target decays geometrically with (1 - coeff)^n.
+ * Each of the eight lanes is advanced by (1 - coeff)^8 per iteration.
+ *
+ * @param[in,out] dst Pointer to buffer, which gets updated
+ * @param nframes Number of samples to process
+ * @param initial Gain of the first sample
+ * @param target Gain to approach
+ * @param coeff Low-pass filter coefficient
+ * @return gain after the last sample
+ */
+float
+x86_sse_avx_apply_gain_ramp_to_buffer (float* dst, uint32_t nframes, float initial, float target, float coeff)
+{
+	const float r = 1.f - coeff;
+	float       d = initial - target;
+
+	if (nframes >= 8) {
+		float  lanes[8];
+		double rk = 1.0;
+		for (int k = 0; k < 8; ++k) {
+			lanes[k] = d * rk;
+			rk *= r;
+		}
+
+		__m256       vd = _mm256_loadu_ps (lanes);
+		const __m256 vr = _mm256_set1_ps ((float)rk);
+		const __m256 vt = _mm256_set1_ps (target);
+
+		while (nframes >= 8) {
+			__m256 x = _mm256_loadu_ps (dst);
+			_mm256_storeu_ps (dst, _mm256_mul_ps (x, _mm256_add_ps (vt, vd)));
+			vd = _mm256_mul_ps (vd, vr);
+			dst += 8;
+			nframes -= 8;
+		}
+
+		d = _mm_cvtss_f32 (_mm256_castps256_ps128 (vd));
+
+		/* zero upper 128 bits of all YMM registers to prevent
+		 * AVX-SSE transition penalties
+		 */
+		_mm256_zeroupper ();
+	}
+
+	while (nframes > 0) {
+		*dst++ *= target + d;
+		d *= r;
+		--nframes;
+	}
+
+	return target + d;
+}
+
+/**
+ * @brief x86-64 AVX optimized routine to apply a gain curve.
+ *
+ * @param[in,out] dst Pointer to buffer, which gets updated
+ * @param[in] gain Pointer to gain coefficients, one per sample
+ * @param nframes Number of samples to process
+ */
+void
+x86_sse_avx_apply_gain_vector_to_buffer (float* dst, float const* gain, uint32_t nframes)
+{
+	while (nframes >= 16) {
+		__m256 x0 = _mm256_loadu_ps (dst + 0);
+		__m256 x1 = _mm256_loadu_ps (dst + 8);
+		_mm256_storeu_ps (dst + 0, _mm256_mul_ps (x0, _mm256_loadu_ps (gain + 0)));
+		_mm256_storeu_ps (dst + 8, _mm256_mul_ps (x1, _mm256_loadu_ps (gain + 8)));
+		dst += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	while (nframes >= 8) {
+		_mm256_storeu_ps (dst, _mm256_mul_ps (_mm256_loadu_ps (dst), _mm256_loadu_ps (gain)));
+		dst += 8;
+		gain += 8;
+		nframes -= 8;
+	}
+
+	while (nframes > 0) {
+		*dst++ *= *gain++;
+		--nframes;
+	}
+
+	/* zero upper 128 bits of all YMM registers to prevent
+	 * AVX-SSE transition penalties
+	 */
+	_mm256_zeroupper ();
+}
@@ -1146,4 +1146,95 @@ x86_avx512f_copy_vector(float *dst, const float *src, uint32_t nframes)
 	_mm256_zeroupper(); // zeros the upper portion of YMM register
 }
 
+/**
+ * @brief x86-64 AVX-512F optimized routine for a declicking gain ramp
+ * @param dst Pointer to buffer, which gets updated
+ * @param nframes Number of frames to process
+ * @param initial Gain of the first sample
+ * @param target Gain to approach
+ * @param coeff Low-pass filter coefficient
+ * @return float Gain after the last sample
+ */
+float
+x86_avx512f_apply_gain_ramp_to_buffer(float *dst, uint32_t nframes, float initial, float target, float coeff)
+{
+	const float r = 1.f - coeff;
+	float d = initial - target;
+
+	if (nframes >= 16) {
+		// Distance to target of 16 consecutive samples: d * r^k
+		float lanes[16];
+		double rk = 1.0;
+		for (int k = 0; k < 16; ++k) {
+			lanes[k] = d * rk;
+			rk *= r;
+		}
+
+		__m512 zd = _mm512_loadu_ps(lanes);
+		const __m512 zr = _mm512_set1_ps((float)rk);
+		const __m512 zt = _mm512_set1_ps(target);
+
+		while (nframes >= 16) {
+			__m512 x = _mm512_loadu_ps(dst);
+			_mm512_storeu_ps(dst, _mm512_mul_ps(x, _mm512_add_ps(zt, zd)));
+			zd = _mm512_mul_ps(zd, zr);
+
+			dst += 16;
+			nframes -= 16;
+		}
+
+		d = _mm512_cvtss_f32(zd);
+	}
+
+	// Process remaining samples
+	while (nframes > 0) {
+		*dst++ *= target + d;
+		d *= r;
+		--nframes;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+
+	return target + d;
+}
+
+/**
+ * @brief x86-64 AVX-512F optimized routine to apply a gain curve
+ * @param dst Pointer to buffer, which gets updated
+ * @param gain Pointer to gain coefficients, one per sample
+ * @param nframes Number of frames to process
+ */
+void
+x86_avx512f_apply_gain_vector_to_buffer(float *dst, const float *gain, uint32_t nframes)
+{
+	// Process samples x32
+	while (nframes >= 32) {
+		__m512 x0 = _mm512_loadu_ps(dst + 0);
+		__m512 x1 = _mm512_loadu_ps(dst + 16);
+		_mm512_storeu_ps(dst + 0, _mm512_mul_ps(x0, _mm512_loadu_ps(gain + 0)));
+		_mm512_storeu_ps(dst + 16, _mm512_mul_ps(x1, _mm512_loadu_ps(gain + 16)));
+
+		dst += 32;
+		gain += 32;
+		nframes -= 32;
+	}
+
+	// Process remaining samples x16
+	while (nframes >= 16) {
+		_mm512_storeu_ps(dst, _mm512_mul_ps(_mm512_loadu_ps(dst), _mm512_loadu_ps(gain)));
+
+		dst += 16;
+		gain += 16;
+		nframes -= 16;
+	}
+
+	// Process remaining samples
+	while (nframes > 0) {
+		*dst++ *= *gain++;
+		--nframes;
+	}
+
+	_mm256_zeroupper(); // zeros the upper portion of YMM register
+}
+
 #endif // FPU_AVX512F_SUPPORT
@@ -18,6 +18,7 @@
 #include "audiographer/source.h"
 #include "audiographer/sink.h"
 #include "audiographer/exception.h"
+#include "audiographer/general/worker_pool.h"
 
 namespace AudioGrapher
 {
@@ -35,7 +36,20 @@ class /*LIBAUDIOGRAPHER_API*/ ThreaderException : public Exception
 	{ }
 };
 
-/// Class for distributing processing across several threads
+/** Class for distributing processing across several threads
+  *
+  * When used with a Glib::ThreadPool, process() only returns once all
+  * outputs have processed the given context.
+  *
+  * When used with a WorkerPool, the context is copied and process()
+  * returns as soon as a buffer for the next context is available.
+  * Each output processes successive contexts in order, but outputs
+  * may lag behind by up to pipeline_depth contexts. This allows the
+  * caller to prepare the next chunk while the outputs are busy.
+  * Once a context flagged EndOfInput was processed by all outputs,
+  * process() returns. Exceptions thrown by outputs are passed on
+  * by the next call to process().
+  */
 template <typename T = DefaultSampleType>
 class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 {
@@ -50,29 +64,74 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 	  * \param wait_timeout_milliseconds maximum time allowed for threads to use in processing
 	  */
 	Threader (Glib::ThreadPool & thread_pool, long wait_timeout_milliseconds = 500)
-	  : thread_pool (thread_pool)
+	  : thread_pool (&thread_pool)
 	  , wait_timeout (wait_timeout_milliseconds)
+	  , worker_pool (0)
+	  , chunk (0)
+	  , running (0)
+	  , slot_sem ("ThreaderSlot", 0)
+	  , exit_sem ("ThreaderExit", 0)
 	{
 		readers.store (0);
+		failed.store (false);
 	}
 
-	virtual ~Threader () {}
+	/** Constructor for pipelined processing
+	  * \param worker_pool persistent threads to run the outputs
+	  * \param pipeline_depth number of contexts that can be in flight
+	  */
+	Threader (WorkerPool & worker_pool, unsigned int pipeline_depth = 4)
+	  : thread_pool (0)
+	  , wait_timeout (0)
+	  , worker_pool (&worker_pool)
+	  , slots (std::max (2u, pipeline_depth))
+	  , chunk (0)
+	  , running (0)
+	  , slot_sem ("ThreaderSlot", 0)
+	  , exit_sem ("ThreaderExit", 0)
+	{
+		readers.store (0);
+		failed.store (false);
+	}
+
+	virtual ~Threader ()
+	{
+		drain ();
+		clear_strands ();
+	}
 
 	/// Adds output \n RT safe
-	void add_output (typename Source<T>::SinkPtr output) { outputs.push_back (output); }
+	void add_output (typename Source<T>::SinkPtr output)
+	{
+		drain ();
+		outputs.push_back (output);
+		update_strands ();
+	}
 
 	/// Clears outputs \n RT safe
-	void clear_outputs () { outputs.clear (); }
+	void clear_outputs ()
+	{
+		drain ();
+		outputs.clear ();
+		update_strands ();
+	}
 
 	/// Removes a specific output \n RT safe
 	void remove_output (typename Source<T>::SinkPtr output) {
+		drain ();
 		typename OutputVec::iterator new_end = std::remove(outputs.begin(), outputs.end(), output);
 		outputs.erase (new_end, outputs.end());
+		update_strands ();
 	}
 
 	/// Processes context concurrently by scheduling each output separately to the given thread pool
 	void process (ProcessContext<T> const & c)
 	{
+		if (worker_pool) {
+			process_pipelined (c);
+			return;
+		}
+
 		wait_mutex.lock();
 
 		exception.reset();
@@ -80,7 +139,7 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 		unsigned int outs = outputs.size();
 		(void) readers.fetch_add (outs);
 		for (unsigned int i = 0; i < outs; ++i) {
-			thread_pool.push (sigc::bind (sigc::mem_fun (this, &Threader::process_output), c, i));
+			thread_pool->push (sigc::bind (sigc::mem_fun (this, &Threader::process_output), c, i));
 		}
 
 		wait();
@@ -90,6 +149,156 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 
   private:
 
+	/* a copy of a context, shared by all outputs */
+	struct Slot {
+		Slot () { pending.store (0); }
+
+		std::vector<T>   data;
+		samplecnt_t      samples;
+		ChannelCount     channels;
+		FlagField        flags;
+		std::atomic<int> pending;
+	};
+
+	/* processes the queued contexts of one output in order */
+	struct Strand : public WorkerPool::Task {
+		Strand (Threader& t, unsigned int o, uint64_t c)
+			: threader (t), output (o), next (c)
+		{
+			queued.store (0);
+		}
+
+		void run ()
+		{
+			Threader* t = &threader;
+
+			do {
+				t->process_slot (output, next++);
+			} while (queued.fetch_sub (1) > 1);
+
+			/* this may be deleted from here on */
+			t->exit_sem.signal ();
+		}
+
+		Threader&        threader;
+		unsigned int     output;
+		uint64_t         next;
+		std::atomic<int> queued;
+	};
+
+	void process_pipelined (ProcessContext<T> const & c)
+	{
+		Slot& slot (slots[chunk % slots.size ()]);
+
+		/* wait for all outputs to process the context that used this slot */
+		while (slot.pending.load () != 0) {
+			slot_sem.wait ();
+		}
+
+		throw_pending ();
+
+		if (strands.empty ()) {
+			return;
+		}
+
+		if (slot.data.size () < (size_t) c.samples ()) {
+			slot.data.resize (c.samples ());
+		}
+		TypeUtils<T>::copy (c.data (), &slot.data[0], c.samples ());
+
+		slot.samples  = c.samples ();
+		slot.channels = c.channels ();
+		slot.flags    = c.flags ();
+		slot.pending.store (strands.size ());
+
+		++chunk;
+
+		for (typename std::vector<Strand*>::iterator s = strands.begin (); s != strands.end (); ++s) {
+			if ((*s)->queued.fetch_add (1) == 0) {
+				++running;
+				worker_pool->push (*s);
+			}
+		}
+
+		if (c.has_flag (ProcessContext<T>::EndOfInput)) {
+			drain ();
+			throw_pending ();
+		}
+	}
+
+	void process_slot (unsigned int output, uint64_t n)
+	{
+		Slot& slot (slots[n % slots.size ()]);
+
+		/* like process_output(), every output processes the context,
+		 * only the first exception is passed on */
+		try {
+			ProcessContext<T> c (slot.data.empty () ? 0 : &slot.data[0], slot.samples, slot.channels);
+			if (slot.flags.has (ProcessContext<T>::EndOfInput)) {
+				c.set_flag (ProcessContext<T>::EndOfInput);
+			}
+			outputs[output]->process (c);
+		} catch (std::exception const & e) {
+			set_exception (e);
+		}
+
+		if (PBD::atomic_dec_and_test (slot.pending)) {
+			slot_sem.signal ();
+		}
+	}
+
+	/// Wait until all queued contexts were processed
+	void drain ()
+	{
+		while (running > 0) {
+			exit_sem.wait ();
+			--running;
+		}
+	}
+
+	void update_strands ()
+	{
+		if (!worker_pool) {
+			return;
+		}
+		clear_strands ();
+		for (unsigned int i = 0; i < outputs.size (); ++i) {
+			strands.push_back (new Strand (*this, i, chunk));
+		}
+	}
+
+	void clear_strands ()
+	{
+		for (typename std::vector<Strand*>::iterator s = strands.begin (); s != strands.end (); ++s) {
+			delete *s;
+		}
+		strands.clear ();
+	}
+
+	void throw_pending ()
+	{
+		if (!failed.load ()) {
+			return;
+		}
+		std::shared_ptr<ThreaderException> e;
+		exception_mutex.lock();
+		e.swap (exception);
+		exception_mutex.unlock();
+		failed.store (false);
+		if (e) {
+			throw *e;
+		}
+	}
+
+	void set_exception (std::exception const & e)
+	{
+		// Only first exception will be passed on
+		exception_mutex.lock();
+		if(!exception) { exception.reset (new ThreaderException (*this, e)); }
+		exception_mutex.unlock();
+		failed.store (true);
+	}
+
 	void wait()
 	{
 		while (readers.load () != 0) {
@@ -109,10 +318,7 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 		try {
 			outputs[output]->process (c);
 		} catch (std::exception const & e) {
-			// Only first exception will be passed on
-			exception_mutex.lock();
-			if(!exception) { exception.reset (new ThreaderException (*this, e)); }
-			exception_mutex.unlock();
+			set_exception (e);
 		}
 
 		if (PBD::atomic_dec_and_test (readers)) {
@@ -122,15 +328,24 @@ class /*LIBAUDIOGRAPHER_API*/ Threader : public Source<T>, public Sink<T>
 
 	OutputVec outputs;
 
-	Glib::ThreadPool&    thread_pool;
+	Glib::ThreadPool*    thread_pool;
 	Glib::Threads::Mutex wait_mutex;
 	Glib::Threads::Cond  wait_cond;
 
 	std::atomic<int> readers;
 	long         wait_timeout;
 
+	WorkerPool*          worker_pool;
+	std::vector<Slot>    slots;
+	std::vector<Strand*> strands;
+	uint64_t             chunk;
+	unsigned int         running; // strands queued or running
+	PBD::Semaphore       slot_sem;
+	PBD::Semaphore       exit_sem;
+
 	Glib::Threads::Mutex exception_mutex;
 	std::shared_ptr<ThreaderException> exception;
+	std::atomic<bool>    failed;
 
 };
 
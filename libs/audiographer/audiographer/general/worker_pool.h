@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef AUDIOGRAPHER_WORKER_POOL_H
+#define AUDIOGRAPHER_WORKER_POOL_H
+
+#include <atomic>
+#include <vector>
+
+#include <glibmm/threads.h>
+
+#include "pbd/mpmc_queue.h"
+#include "pbd/pthread_utils.h"
+#include "pbd/semutils.h"
+
+#include "audiographer/visibility.h"
+
+namespace AudioGrapher
+{
+
+/** A set of persistent threads to run tasks of export graphs.
+  *
+  * Tasks are passed through a lock-free queue, idle workers sleep
+  * on a semaphore. Unlike Glib::ThreadPool no memory is allocated
+  * when a task is queued, and there is no lock contention between
+  * the thread that queues tasks and the workers.
+  *
+  * Threads are started when the first task is queued.
+  */
+class LIBAUDIOGRAPHER_API WorkerPool
+{
+  public:
+	/// A unit of work. The task must remain valid until run() returned
+	class Task
+	{
+	  public:
+		virtual ~Task () {}
+		virtual void run () = 0;
+	};
+
+	/** Constructor
+	  * \param n_threads number of worker threads, 0: number of CPU cores
+	  * \param queue_size maximum number of queued tasks
+	  */
+	WorkerPool (unsigned int n_threads = 0, size_t queue_size = 1024);
+	~WorkerPool ();
+
+	unsigned int n_threads () const { return _n_threads; }
+
+	/** Queue a task. If the queue is full, the task is run
+	  * directly in the calling thread.
+	  */
+	void push (Task* task);
+
+  private:
+	void start ();
+	void worker ();
+
+	unsigned int              _n_threads;
+	std::atomic<bool>         _started;
+	Glib::Threads::Mutex      _start_lock;
+	std::vector<PBD::Thread*> _threads;
+	PBD::MPMCQueue<Task*>     _queue;
+	PBD::Semaphore            _sem;
+	std::atomic<bool>         _terminate;
+};
+
+} // namespace
+
+#endif // AUDIOGRAPHER_WORKER_POOL_H
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+
+#include <boost/bind.hpp>
+
+#include "pbd/cpus.h"
+
+#include "audiographer/general/worker_pool.h"
+
+namespace AudioGrapher
+{
+
+WorkerPool::WorkerPool (unsigned int n_threads, size_t queue_size)
+	: _n_threads (n_threads > 0 ? n_threads : std::max<uint32_t> (1, hardware_concurrency ()))
+	, _started (false)
+	, _queue (queue_size)
+	, _sem ("AudioGrapherWorkers", 0)
+	, _terminate (false)
+{
+}
+
+WorkerPool::~WorkerPool ()
+{
+	_terminate.store (true);
+
+	for (size_t i = 0; i < _threads.size (); ++i) {
+		_sem.signal ();
+	}
+
+	for (std::vector<PBD::Thread*>::iterator i = _threads.begin (); i != _threads.end (); ++i) {
+		(*i)->join ();
+		delete *i;
+	}
+}
+
+void
+WorkerPool::start ()
+{
+	Glib::Threads::Mutex::Lock lm (_start_lock);
+
+	if (_started.load ()) {
+		return;
+	}
+
+	for (unsigned int i = 0; i < _n_threads; ++i) {
+		PBD::Thread* t = PBD::Thread::create (boost::bind (&WorkerPool::worker, this), "ExportWorker");
+		if (!t) {
+			break;
+		}
+		_threads.push_back (t);
+	}
+
+	_started.store (true);
+}
+
+void
+WorkerPool::push (Task* task)
+{
+	if (!_started.load ()) {
+		start ();
+	}
+
+	if (_threads.empty () || !_queue.push_back (task)) {
+		task->run ();
+		return;
+	}
+	_sem.signal ();
+}
+
+void
+WorkerPool::worker ()
+{
+	while (true) {
+		_sem.wait ();
+
+		Task* task;
+		while (_queue.pop_front (task)) {
+			task->run ();
+		}
+
+		if (_terminate.load ()) {
+			break;
+		}
+	}
+}
+
+} // namespace
@@ -11,6 +11,8 @@ class ThreaderTest : public CppUnit::TestFixture
   CPPUNIT_TEST (testRemoveOutput);
   CPPUNIT_TEST (testClearOutputs);
   CPPUNIT_TEST (testExceptions);
+  CPPUNIT_TEST (testPipelined);
+  CPPUNIT_TEST (testPipelinedExceptions);
   CPPUNIT_TEST_SUITE_END ();
 
   public:
@@ -25,6 +27,9 @@ class ThreaderTest : public CppUnit::TestFixture
 		thread_pool = new Glib::ThreadPool (3);
 		threader.reset (new Threader<float> (*thread_pool));
 
+		worker_pool = new WorkerPool (3);
+		pipelined.reset (new Threader<float> (*worker_pool, 2));
+
 		sink_a.reset (new VectorSink<float>());
 		sink_b.reset (new VectorSink<float>());
 		sink_c.reset (new VectorSink<float>());
@@ -42,6 +47,9 @@ class ThreaderTest : public CppUnit::TestFixture
 
 		thread_pool->shutdown();
 		delete thread_pool;
+
+		pipelined.reset ();
+		delete worker_pool;
 	}
 
 	void testProcess()
@@ -134,10 +142,76 @@ class ThreaderTest : public CppUnit::TestFixture
 		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_e->get_array(), samples));
 	}
 
+	void testPipelined()
+	{
+		pipelined->add_output (sink_a);
+		pipelined->add_output (sink_b);
+		pipelined->add_output (sink_c);
+
+		std::shared_ptr<AppendingVectorSink<float> > appending (new AppendingVectorSink<float>());
+		pipelined->add_output (appending);
+
+		/* more contexts than the pipeline is deep, the source
+		 * data is only valid during process ()
+		 */
+		float * data = new float[samples];
+		for (int i = 0; i < 4; ++i) {
+			memcpy (data, random_data, samples * sizeof(float));
+			ProcessContext<float> c (data, samples, 1);
+			pipelined->process (c);
+			memset (data, 0, samples * sizeof(float));
+		}
+
+		memcpy (data, zero_data, samples * sizeof(float));
+		ProcessContext<float> zc (data, samples, 1);
+		zc.set_flag (ProcessContext<float>::EndOfInput);
+		pipelined->process (zc);
+		delete [] data;
+
+		/* all outputs are done once EndOfInput was processed */
+		CPPUNIT_ASSERT (TestUtils::array_equals(zero_data, sink_a->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(zero_data, sink_b->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(zero_data, sink_c->get_array(), samples));
+
+		/* contexts are processed in order */
+		CPPUNIT_ASSERT_EQUAL ((size_t) 5 * samples, appending->get_data().size());
+		for (int i = 0; i < 4; ++i) {
+			CPPUNIT_ASSERT (TestUtils::array_equals(random_data, appending->get_array() + i * samples, samples));
+		}
+		CPPUNIT_ASSERT (TestUtils::array_equals(zero_data, appending->get_array() + 4 * samples, samples));
+
+		pipelined->remove_output (sink_b);
+		pipelined->remove_output (appending);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		pipelined->process (c);
+
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_a->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(zero_data, sink_b->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_c->get_array(), samples));
+	}
+
+	void testPipelinedExceptions()
+	{
+		pipelined->add_output (sink_a);
+		pipelined->add_output (throwing_sink);
+		pipelined->add_output (sink_c);
+
+		ProcessContext<float> c (random_data, samples, 1);
+		c.set_flag (ProcessContext<float>::EndOfInput);
+		CPPUNIT_ASSERT_THROW (pipelined->process (c), Exception);
+
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_a->get_array(), samples));
+		CPPUNIT_ASSERT (TestUtils::array_equals(random_data, sink_c->get_array(), samples));
+	}
+
   private:
 	Glib::ThreadPool * thread_pool;
+	WorkerPool * worker_pool;
 
 	std::shared_ptr<Threader<float> > threader;
+	std::shared_ptr<Threader<float> > pipelined;
 	std::shared_ptr<VectorSink<float> > sink_a;
 	std::shared_ptr<VectorSink<float> > sink_b;
 	std::shared_ptr<VectorSink<float> > sink_c;
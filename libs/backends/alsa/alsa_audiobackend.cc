@@ -1795,7 +1795,7 @@ AlsaAudioBackend::port_factory (std::string const& name, ARDOUR::DataType type,
 void*
 AlsaAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	BackendPortPtr port = std::dynamic_pointer_cast<BackendPort> (port_handle);
+	BackendPort* port = backend_port (port_handle);
 	assert (port);
 	return port->get_buffer (nframes);
 }
@@ -1937,7 +1937,7 @@ AlsaAudioBackend::main_process_thread ()
 					}
 					i = 0;
 					for (std::vector<BackendPortPtr>::const_iterator it = (*s)->inputs.begin (); it != (*s)->inputs.end (); ++it, ++i) {
-						(*s)->capt_chan (i, (float*)(std::dynamic_pointer_cast<BackendPort> (*it)->get_buffer (_samples_per_period)), _samples_per_period);
+						(*s)->capt_chan (i, (float*)(*it)->get_buffer (_samples_per_period), _samples_per_period);
 					}
 				}
 
@@ -2330,17 +2330,17 @@ void*
 AlsaAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		std::vector<BackendPort*>::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<const AlsaAudioPort> source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
-			assert (source && source->is_output ());
+			const AlsaAudioPort* source = static_cast<const AlsaAudioPort*> (*it);
+			assert (source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<const AlsaAudioPort> (*it);
-				assert (source && source->is_output ());
+			while (++it != sources->end ()) {
+				source = static_cast<const AlsaAudioPort*> (*it);
+				assert (source->is_output ());
 				Sample*       dst = buffer ();
 				const Sample* src = source->const_buffer ();
 				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
@@ -2381,11 +2381,11 @@ void* AlsaMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		for (std::vector<BackendPort*>::const_iterator i = sources->begin ();
+		     i != sources->end ();
 		     ++i) {
-			const AlsaMidiBuffer* src = std::dynamic_pointer_cast<const AlsaMidiPort> (*i)->const_buffer ();
+			const AlsaMidiBuffer* src = static_cast<const AlsaMidiPort*> (*i)->const_buffer ();
 			for (AlsaMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
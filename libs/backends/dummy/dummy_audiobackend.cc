@@ -927,9 +927,9 @@ DummyAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool f
 void*
 DummyAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	BackendPortPtr port = std::dynamic_pointer_cast<BackendPort> (port_handle);
+	BackendPort* port = backend_port (port_handle);
 	assert (port);
-	assert (valid_port (port));
+	assert (valid_port (std::dynamic_pointer_cast<BackendPort> (port_handle)));
 	return port->get_buffer (nframes);
 }
 
@@ -1629,20 +1629,20 @@ void*
 DummyAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it = connections.begin ();
-		if (it == connections.end ()) {
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		std::vector<BackendPort*>::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<DummyAudioPort> source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
-			assert (source && source->is_output ());
+			DummyAudioPort* source = static_cast<DummyAudioPort*>(*it);
+			assert (source->is_output ());
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<DummyAudioPort>(*it);
-				assert (source && source->is_output ());
+			while (++it != sources->end ()) {
+				source = static_cast<DummyAudioPort*>(*it);
+				assert (source->is_output ());
 				Sample* dst = buffer ();
 				if (source->is_physical() && source->is_terminal()) {
 					source->get_buffer(n_samples); // generate signal.
@@ -1907,11 +1907,11 @@ void* DummyMidiPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-				i != connections.end ();
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		for (std::vector<BackendPort*>::const_iterator i = sources->begin ();
+				i != sources->end ();
 				++i) {
-			std::shared_ptr<DummyMidiPort> source = std::dynamic_pointer_cast<DummyMidiPort>(*i);
+			DummyMidiPort* source = static_cast<DummyMidiPort*>(*i);
 			if (source->is_physical() && source->is_terminal()) {
 				source->get_buffer(n_samples); // generate signal.
 			}
@@ -1526,7 +1526,7 @@ PortAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool fo
 void*
 PortAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	std::shared_ptr<BackendPort> port = std::dynamic_pointer_cast<BackendPort>(port_handle);
+	BackendPort* port = backend_port (port_handle);
 	assert (port);
 	return port->get_buffer (nframes);
 }
@@ -1921,16 +1921,17 @@ PortAudioPort::~PortAudioPort () { }
 void* PortAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		std::set<BackendPortPtr>::const_iterator it = get_connections ().begin ();
-		if (it == get_connections ().end ()) {
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		std::vector<BackendPort*>::const_iterator it = sources->begin ();
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<const PortAudioPort> source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-			assert (source && source->is_output ());
+			const PortAudioPort* source = static_cast<const PortAudioPort*>(*it);
+			assert (source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != get_connections ().end ()) {
-				source = std::dynamic_pointer_cast<const PortAudioPort>(*it);
-				assert (source && source->is_output ());
+			while (++it != sources->end ()) {
+				source = static_cast<const PortAudioPort*>(*it);
+				assert (source->is_output ());
 				Sample* dst = buffer ();
 				const Sample* src = source->const_buffer ();
 				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
@@ -1967,10 +1968,11 @@ void* PortMidiPort::get_buffer (pframes_t /* nframes */)
 {
 	if (is_input ()) {
 		(_buffer[_bufperiod]).clear ();
-		for (std::set<BackendPortPtr>::const_iterator i = get_connections ().begin ();
-				i != get_connections ().end ();
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		for (std::vector<BackendPort*>::const_iterator i = sources->begin ();
+				i != sources->end ();
 				++i) {
-			const PortMidiBuffer * src = std::dynamic_pointer_cast<const PortMidiPort>(*i)->const_buffer ();
+			const PortMidiBuffer * src = static_cast<const PortMidiPort*>(*i)->const_buffer ();
 			for (PortMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				(_buffer[_bufperiod]).push_back (*it);
 			}
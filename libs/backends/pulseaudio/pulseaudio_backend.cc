@@ -970,7 +970,7 @@ PulseAudioBackend::get_latency_range (PortEngine::PortHandle port_handle, bool f
 void*
 PulseAudioBackend::get_buffer (PortEngine::PortHandle port_handle, pframes_t nframes)
 {
-	BackendPortPtr port = std::dynamic_pointer_cast<BackendPort> (port_handle);
+	BackendPort* port = backend_port (port_handle);
 	assert (port);
 	return port->get_buffer (nframes);
 }
@@ -1199,18 +1199,18 @@ void*
 PulseAudioPort::get_buffer (pframes_t n_samples)
 {
 	if (is_input ()) {
-		const std::set<BackendPortPtr>&          connections = get_connections ();
-		std::set<BackendPortPtr>::const_iterator it          = connections.begin ();
+		BackendPort::PortSourcesPtr               sources = get_sources ();
+		std::vector<BackendPort*>::const_iterator it      = sources->begin ();
 
-		if (it == connections.end ()) {
+		if (it == sources->end ()) {
 			memset (_buffer, 0, n_samples * sizeof (Sample));
 		} else {
-			std::shared_ptr<PulseAudioPort> source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-			assert (source && source->is_output ());
+			const PulseAudioPort* source = static_cast<const PulseAudioPort*> (*it);
+			assert (source->is_output ());
 			memcpy (_buffer, source->const_buffer (), n_samples * sizeof (Sample));
-			while (++it != connections.end ()) {
-				source = std::dynamic_pointer_cast<PulseAudioPort> (*it);
-				assert (source && source->is_output ());
+			while (++it != sources->end ()) {
+				source = static_cast<const PulseAudioPort*> (*it);
+				assert (source->is_output ());
 				Sample*       dst = _buffer;
 				const Sample* src = source->const_buffer ();
 				for (uint32_t s = 0; s < n_samples; ++s, ++dst, ++src) {
@@ -1245,11 +1245,11 @@ void* PulseMidiPort::get_buffer (pframes_t /*n_samples*/)
 {
 	if (is_input ()) {
 		_buffer.clear ();
-		const std::set<BackendPortPtr>& connections = get_connections ();
-		for (std::set<BackendPortPtr>::const_iterator i = connections.begin ();
-		     i != connections.end ();
+		BackendPort::PortSourcesPtr sources = get_sources ();
+		for (std::vector<BackendPort*>::const_iterator i = sources->begin ();
+		     i != sources->end ();
 		     ++i) {
-			const PulseMidiBuffer* src = std::dynamic_pointer_cast<PulseMidiPort> (*i)->const_buffer ();
+			const PulseMidiBuffer* src = static_cast<const PulseMidiPort*> (*i)->const_buffer ();
 			for (PulseMidiBuffer::const_iterator it = src->begin (); it != src->end (); ++it) {
 				_buffer.push_back (*it);
 			}
@@ -35,6 +35,7 @@
 
 #define GUARD_POINT_DELTA(foo) ((foo).time_domain () == Temporal::AudioTime ? Temporal::timecnt_t (64) : Temporal::timecnt_t (Beats (0, 1)))
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
 #include <iostream>
@@ -78,6 +79,8 @@ ControlList::ControlList (const Parameter& id, const ParameterDescriptor& desc,
 	_lookup_cache.range.second  = _events.end ();
 	_search_cache.left          = timepos_t::max (time_domain());
 	_search_cache.first         = _events.end ();
+	_eval_points_dirty          = true;
+	_eval_cursor                = 0;
 	_sort_pending               = false;
 	new_write_pass              = true;
 	_in_write_pass              = false;
@@ -98,6 +101,8 @@ ControlList::ControlList (const ControlList& other)
 	_lookup_cache.range.first   = _events.end ();
 	_lookup_cache.range.second  = _events.end ();
 	_search_cache.first         = _events.end ();
+	_eval_points_dirty          = true;
+	_eval_cursor                = 0;
 	_sort_pending               = false;
 	new_write_pass              = true;
 	_in_write_pass              = false;
@@ -121,6 +126,8 @@ ControlList::ControlList (const ControlList& other, timepos_t const& start, time
 	_lookup_cache.range.first  = _events.end ();
 	_lookup_cache.range.second = _events.end ();
 	_search_cache.first        = _events.end ();
+	_eval_points_dirty         = true;
+	_eval_cursor               = 0;
 	_sort_pending              = false;
 
 	/* now grab the relevant points, and shift them back if necessary */
@@ -1313,6 +1320,7 @@ ControlList::thaw ()
 			unlocked_remove_duplicates ();
 			unlocked_invalidate_insert_iterator ();
 			_sort_pending = false;
+			mark_dirty ();
 		}
 	}
 	maybe_signal_changed ();
@@ -1327,6 +1335,15 @@ ControlList::mark_dirty () const
 	_search_cache.left         = timepos_t::max (time_domain());
 	_search_cache.first        = _events.end ();
 
+	_eval_points_dirty = true;
+
+	/* make room here (the writer-lock is held), so that the eval index
+	 * can be rebuilt without allocating, see unlocked_eval_points().
+	 */
+	if (_eval_points.capacity () < _events.size ()) {
+		_eval_points.reserve (_events.size () + _events.size () / 4 + 16);
+	}
+
 	if (_curve) {
 		_curve->mark_dirty ();
 	}
@@ -1598,87 +1615,128 @@ ControlList::unlocked_eval (timepos_t const& xtime) const
 	return _desc.normal;
 }
 
-double
-ControlList::multipoint_eval (timepos_t const& xtime) const
+ControlList::EvalPoints const*
+ControlList::unlocked_eval_points () const
 {
-	timepos_t upos, lpos;
-	double    uval, lval;
-	double    fraction;
+	if (!_eval_points_dirty.load (std::memory_order_acquire) && _eval_points.size () == _events.size ()) {
+		return &_eval_points;
+	}
 
-	/* "Stepped" lookup (no interpolation) */
-	/* FIXME: no cache.  significant? */
-	if (_interpolation == Discrete) {
-		const ControlEvent        cp (xtime, 0);
-		EventList::const_iterator i = lower_bound (_events.begin (), _events.end (), &cp, time_comparator);
+	/* several readers can share the read-lock, only one of them rebuilds
+	 * the index. The others fall back to searching the event list.
+	 */
+	Glib::Threads::Mutex::Lock lm (_eval_lock, Glib::Threads::TRY_LOCK);
 
-		// shouldn't have made it to multipoint_eval
-		assert (i != _events.end ());
+	if (!lm.locked ()) {
+		return 0;
+	}
 
-		if (i == _events.begin () || (*i)->when == xtime)
-			return (*i)->value;
-		else
-			return (*(--i))->value;
+	if (!_eval_points_dirty.load (std::memory_order_acquire) && _eval_points.size () == _events.size ()) {
+		return &_eval_points;
 	}
 
-	/* Only do the range lookup if xtime is in a different range than last time
-	 * this was called (or if the lookup cache has been marked "dirty" (left<0) */
-	if ((_lookup_cache.left == timepos_t::max (time_domain())) ||
-	    ((_lookup_cache.left > xtime) ||
-	     (_lookup_cache.range.first == _events.end ()) ||
-	     ((*_lookup_cache.range.second)->when < xtime))) {
-		const ControlEvent cp (xtime, 0);
+	if (_eval_points.capacity () < _events.size ()) {
+		/* this may be a realtime thread, do not allocate */
+		return 0;
+	}
 
-		_lookup_cache.range = equal_range (_events.begin (), _events.end (), &cp, time_comparator);
+	_eval_points.clear ();
+	for (const_iterator i = _events.begin (); i != _events.end (); ++i) {
+		_eval_points.push_back (EvalPoint (*i));
 	}
 
-	pair<const_iterator, const_iterator> range = _lookup_cache.range;
+	_eval_cursor = 0;
+	_eval_points_dirty.store (false, std::memory_order_release);
+
+	return &_eval_points;
+}
+
+static bool
+eval_point_before (ControlList::EvalPoint const& p, timepos_t const& x)
+{
+	return p.when < x;
+}
+
+void
+ControlList::unlocked_find_neighbours (timepos_t const& x, ControlEvent const*& before, ControlEvent const*& after) const
+{
+	EvalPoints const* pts = unlocked_eval_points ();
+
+	if (!pts) {
+		const ControlEvent cp (x, 0);
+		const_iterator     i = lower_bound (_events.begin (), _events.end (), &cp, time_comparator);
 
-	if (range.first == range.second) {
-		/* x does not exist within the list as a control point */
+		after  = (i == _events.end ()) ? 0 : *i;
+		before = (i == _events.begin ()) ? 0 : *(--i);
+		return;
+	}
 
-		_lookup_cache.left = xtime;
+	size_t const n = pts->size ();
 
-		if (range.first != _events.begin ()) {
-			--range.first;
-			lpos = (*range.first)->when;
-			lval = (*range.first)->value;
+	/* most lookups are sequential (process cycles, curve rendering),
+	 * so check the interval used last time, and the next one, before
+	 * doing a binary search.
+	 */
+	size_t i = _eval_cursor.load (std::memory_order_relaxed);
+
+	if (i > 0 && i < n && (*pts)[i - 1].when < x) {
+		if (x <= (*pts)[i].when) {
+			/* same interval */
+		} else if (i + 1 < n && x <= (*pts)[i + 1].when) {
+			++i;
 		} else {
-			/* we're before the first point */
-			// return _default_value;
-			return _events.front ()->value;
+			i = lower_bound (pts->begin () + i, pts->end (), x, eval_point_before) - pts->begin ();
 		}
+	} else {
+		i = lower_bound (pts->begin (), pts->end (), x, eval_point_before) - pts->begin ();
+	}
 
-		if (range.second == _events.end ()) {
-			/* we're after the last point */
-			return _events.back ()->value;
-		}
+	_eval_cursor.store (i, std::memory_order_relaxed);
 
-		upos = (*range.second)->when;
-		uval = (*range.second)->value;
+	after  = (i == n) ? 0 : (*pts)[i].event;
+	before = (i == 0) ? 0 : (*pts)[i - 1].event;
+}
 
-		fraction = (double)lpos.distance (xtime).distance ().val () / (double)lpos.distance (upos).distance ().val ();
+double
+ControlList::multipoint_eval (timepos_t const& xtime) const
+{
+	ControlEvent const* before;
+	ControlEvent const* after;
 
-		switch (_interpolation) {
-			case Logarithmic:
-				return interpolate_logarithmic (lval, uval, fraction, _desc.lower, _desc.upper);
-			case Exponential:
-				return interpolate_gain (lval, uval, fraction, _desc.upper);
-			case Discrete:
-				/* should not reach here */
-				assert (0);
-			case Curved:
-				/* only used x-fade curves, never direct eval */
-				assert (0);
-			default: // Linear
-				return interpolate_linear (lval, uval, fraction);
-				break;
-		}
-		assert (0);
+	unlocked_find_neighbours (xtime, before, after);
+
+	// shouldn't have made it to multipoint_eval
+	assert (after);
+
+	if (!before || after->when == xtime) {
+		/* x is a control point in the data, or we're before the first point */
+		return after->value;
+	}
+
+	if (_interpolation == Discrete) {
+		/* "Stepped" lookup (no interpolation) */
+		return before->value;
 	}
 
-	/* x is a control point in the data */
-	_lookup_cache.left = timepos_t::max (time_domain());
-	return (*range.first)->value;
+	const double fraction = (double)before->when.distance (xtime).distance ().val () / (double)before->when.distance (after->when).distance ().val ();
+
+	switch (_interpolation) {
+		case Logarithmic:
+			return interpolate_logarithmic (before->value, after->value, fraction, _desc.lower, _desc.upper);
+		case Exponential:
+			return interpolate_gain (before->value, after->value, fraction, _desc.upper);
+		case Discrete:
+			/* should not reach here */
+			assert (0);
+		case Curved:
+			/* only used x-fade curves, never direct eval */
+			assert (0);
+		default: // Linear
+			return interpolate_linear (before->value, after->value, fraction);
+	}
+
+	abort (); /*NOTREACHED*/
+	return _desc.normal;
 }
 
 void
@@ -2268,6 +2326,8 @@ ControlList::finish_domain_bounce (Temporal::DomainBounceInfo& dbi)
 			t.set_time_domain (dbi.from);
 			e->when = t;
 		}
+		/* event times changed, invalidate caches and the eval index */
+		mark_dirty ();
 	}
 
 	maybe_signal_changed ();
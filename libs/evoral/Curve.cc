@@ -379,111 +379,179 @@ Curve::_get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *vec,
 		dx = (hx - lx) / (veclen - 1);
 	}
 
-	for (i = 0; i < veclen; ++i, rx += dx) {
-		vec[i] = multipoint_eval (x0.is_beats() ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
+	/* render one segment between two control points at a time, the
+	 * neighbours only need to be looked up at segment boundaries.
+	 */
+	i = 0;
+	while (i < veclen) {
+		Temporal::timepos_t const x (x0.is_beats() ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
+		ControlEvent const* before;
+		ControlEvent const* after;
+
+		_list.unlocked_find_neighbours (x, before, after);
+
+		if (!after) {
+			/* we're after the last point */
+			const float val = _list.events().back()->value;
+			for (; i < veclen; ++i) {
+				vec[i] = val;
+			}
+			break;
+		}
+
+		if (!before || after->when == x) {
+			/* x is a control point in the data, or we're before the first point */
+			vec[i++] = after->value;
+			rx += dx;
+			continue;
+		}
+
+		i = render_segment (before, after, vec, i, veclen, rx, dx);
 	}
 }
 
-double
-Curve::multipoint_eval (Temporal::timepos_t const & x) const
+/** Fill @a vec from index @a i with the values of the segment between
+ * @a before and @a after, as multipoint_eval() would compute them,
+ * until either the end of the segment or of the vector is reached.
+ *
+ * @return index of the first sample that was not rendered
+ */
+int32_t
+Curve::render_segment (ControlEvent const* before, ControlEvent const* after, float* vec, int32_t i, int32_t veclen, double& rx, double dx) const
 {
-	pair<ControlList::EventList::const_iterator,ControlList::EventList::const_iterator> range;
-
-	ControlList::LookupCache& lookup_cache = _list.lookup_cache();
-
-	if ((lookup_cache.left == Temporal::timepos_t::max (_list.time_domain())) ||
-	    ((lookup_cache.left > x) ||
-	     (lookup_cache.range.first == _list.events().end()) ||
-	     ((*lookup_cache.range.second)->when < x))) {
-
-		ControlEvent cp (x, 0.0);
-
-		lookup_cache.range = equal_range (_list.events().begin(), _list.events().end(), &cp, ControlList::time_comparator);
+	/* positions are truncated to integer time, like the timepos_t
+	 * in _get_vector() and multipoint_eval()
+	 */
+	const int64_t aw     = after->when.val();
+	const int64_t bw     = before->when.val();
+	const double  bval   = before->value;
+	const double  vdelta = after->value - bval;
+	const double  trange = aw - bw;
+
+	if (dx == 0) {
+		/* all remaining samples are at the same position */
+		const float val = multipoint_eval (after->when.is_beats () ? Temporal::timepos_t::from_ticks (rx) : Temporal::timepos_t::from_superclock (rx));
+		for (; i < veclen; ++i) {
+			vec[i] = val;
+		}
+		return i;
 	}
 
-	range = lookup_cache.range;
+	ControlList::InterpolationStyle style = _list.interpolation();
 
-	/* EITHER
-
-	   a) x is an existing control point, so first == existing point, second == next point
+	if (vdelta == 0.0) {
+		style = ControlList::Discrete;
+	} else if (style == ControlList::Curved && !after->coeff) {
+		style = ControlList::Linear;
+	}
 
-	   OR
+	switch (style) {
+		case ControlList::Discrete:
+			for (; i < veclen && (int64_t) rx < aw; ++i, rx += dx) {
+				vec[i] = bval;
+			}
+			break;
+		case ControlList::Linear:
+			for (; i < veclen && (int64_t) rx < aw; ++i, rx += dx) {
+				vec[i] = bval + (vdelta * (((int64_t) rx - bw) / trange));
+			}
+			break;
+		case ControlList::Logarithmic:
+			{
+				const double lower = _list.descriptor().lower;
+				const double upper = _list.descriptor().upper;
+				for (; i < veclen && (int64_t) rx < aw; ++i, rx += dx) {
+					vec[i] = interpolate_logarithmic (bval, after->value, ((int64_t) rx - bw) / trange, lower, upper);
+				}
+			}
+			break;
+		case ControlList::Exponential:
+			{
+				const double upper = _list.descriptor().upper;
+				for (; i < veclen && (int64_t) rx < aw; ++i, rx += dx) {
+					vec[i] = interpolate_gain (bval, after->value, ((int64_t) rx - bw) / trange, upper);
+				}
+			}
+			break;
+		case ControlList::Curved:
+			{
+				double const* c = after->coeff;
+				for (; i < veclen && (int64_t) rx < aw; ++i, rx += dx) {
+					const double xv  = (int64_t) rx;
+					const double xv2 = xv * xv;
+					vec[i] = c[0] + (c[1] * xv) + (c[2] * xv2) + (c[3] * xv2 * xv);
+				}
+			}
+			break;
+	}
 
-	   b) x is between control points, so range is empty (first == second, points to where
-	       to insert x)
+	return i;
+}
 
-	*/
+double
+Curve::multipoint_eval (Temporal::timepos_t const & x) const
+{
+	ControlEvent const* before;
+	ControlEvent const* after;
 
-	if (range.first == range.second) {
+	_list.unlocked_find_neighbours (x, before, after);
 
-		/* x does not exist within the list as a control point */
+	if (!after) {
+		/* we're after the last point */
+		return _list.events().back()->value;
+	}
 
-		lookup_cache.left = x;
+	if (!before || after->when == x) {
+		/* x is a control point in the data, or we're before the first point */
+		return after->value;
+	}
 
-		if (range.first == _list.events().begin()) {
-			/* we're before the first point */
-			// return default_value;
-			return _list.events().front()->value;
-		}
+	double vdelta = after->value - before->value;
 
-		if (range.second == _list.events().end()) {
-			/* we're after the last point */
-			return _list.events().back()->value;
-		}
+	if (vdelta == 0.0) {
+		return before->value;
+	}
 
-		ControlEvent* after = (*range.second);
-		range.second--;
-		ControlEvent* before = (*range.second);
+	double aw = after->when.val();
+	double bw = before->when.val();
 
-		double vdelta = after->value - before->value;
+	double tdelta = x.val() - bw;
+	double trange = aw - bw;
 
-		if (vdelta == 0.0) {
+	switch (_list.interpolation()) {
+		case ControlList::Discrete:
 			return before->value;
-		}
-
-		double aw = after->when.val();
-		double bw = before->when.val();
-
-		double tdelta = x.val() - bw;
-		double trange = aw - bw;
-
-		switch (_list.interpolation()) {
-			case ControlList::Discrete:
-				return before->value;
-			case ControlList::Logarithmic:
-				return interpolate_logarithmic (before->value, after->value, tdelta / trange, _list.descriptor().lower, _list.descriptor().upper);
-			case ControlList::Exponential:
-				return interpolate_gain (before->value, after->value, tdelta / trange, _list.descriptor().upper);
-			case ControlList::Curved:
-				if (after->coeff) {
-					ControlEvent* ev = after;
-
-					/* As of Jan 2020, we only use Curved
-					 * for fade in/out curves (of audio
-					 * regions).
-					 *
-					 * This means that x is a relatively
-					 * small value (an offset into the
-					 * fade) amd we do not need to worry
-					 * about the square or cube overflowing
-					 * a double type. They can overflow an
-					 * int64_t by around 6 seconds.
-					 */
-
-					const double xv = x.val();
-					double xv2 = xv * xv;
-					return ev->coeff[0] + (ev->coeff[1] * xv) + (ev->coeff[2] * xv2) + (ev->coeff[3] * xv2 * xv);
-				}
-				/* fallthrough */
-			case ControlList::Linear:
-				return before->value + (vdelta * (tdelta / trange));
-		}
+		case ControlList::Logarithmic:
+			return interpolate_logarithmic (before->value, after->value, tdelta / trange, _list.descriptor().lower, _list.descriptor().upper);
+		case ControlList::Exponential:
+			return interpolate_gain (before->value, after->value, tdelta / trange, _list.descriptor().upper);
+		case ControlList::Curved:
+			if (after->coeff) {
+				ControlEvent const* ev = after;
+
+				/* As of Jan 2020, we only use Curved
+				 * for fade in/out curves (of audio
+				 * regions).
+				 *
+				 * This means that x is a relatively
+				 * small value (an offset into the
+				 * fade) amd we do not need to worry
+				 * about the square or cube overflowing
+				 * a double type. They can overflow an
+				 * int64_t by around 6 seconds.
+				 */
+
+				const double xv = x.val();
+				double xv2 = xv * xv;
+				return ev->coeff[0] + (ev->coeff[1] * xv) + (ev->coeff[2] * xv2) + (ev->coeff[3] * xv2 * xv);
+			}
+			/* fallthrough */
+		case ControlList::Linear:
+			return before->value + (vdelta * (tdelta / trange));
 	}
 
-	/* x is a control point in the data */
-	/* invalidate the cached range because its not usable */
-	lookup_cache.left = Temporal::timepos_t::max (_list.time_domain());
-	return (*range.first)->value;
+	/*NOTREACHED*/
+	return before->value;
 }
 
 } // namespace Evoral
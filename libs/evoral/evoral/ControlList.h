@@ -23,8 +23,10 @@
 #ifndef EVORAL_CONTROL_LIST_HPP
 #define EVORAL_CONTROL_LIST_HPP
 
+#include <atomic>
 #include <cassert>
 #include <list>
+#include <vector>
 #include <stdint.h>
 
 #include <boost/pool/pool.hpp>
@@ -300,6 +302,29 @@ public:
 		ControlList::const_iterator first;
 	};
 
+	/** Contiguous, time-ordered index of the events, used for evaluation.
+	 *
+	 * The event list is a linked list, since iterators into it must stay
+	 * valid while other points are edited. Searching it means chasing a
+	 * pointer per event, so evaluation does a binary search on this array
+	 * instead. It is rebuilt on demand after the list was modified.
+	 */
+	struct EvalPoint {
+		EvalPoint (ControlEvent const* ev) : when (ev->when), event (ev) {}
+		Temporal::timepos_t when;
+		ControlEvent const* event;
+	};
+	typedef std::vector<EvalPoint> EvalPoints;
+
+	/** Find the events surrounding a given time. Must be called with the
+	 * lock held.
+	 *
+	 * @param x time to look up
+	 * @param before set to the last event earlier than x, or 0
+	 * @param after set to the first event at or after x, or 0
+	 */
+	void unlocked_find_neighbours (Temporal::timepos_t const & x, ControlEvent const*& before, ControlEvent const*& after) const;
+
 	/** @return the list of events */
 	const EventList& events() const { return _events; }
 
@@ -382,6 +407,8 @@ public:
 
 	void build_search_cache_if_necessary (Temporal::timepos_t const & start) const;
 
+	EvalPoints const* unlocked_eval_points () const;
+
 	std::shared_ptr<ControlList> cut_copy_clear (Temporal::timepos_t const &, Temporal::timepos_t const &, int op);
 	bool erase_range_internal (Temporal::timepos_t const & start, Temporal::timepos_t const & end, EventList &);
 
@@ -396,6 +423,11 @@ public:
 	mutable LookupCache   _lookup_cache;
 	mutable SearchCache   _search_cache;
 
+	mutable EvalPoints           _eval_points;
+	mutable std::atomic<bool>    _eval_points_dirty;
+	mutable std::atomic<size_t>  _eval_cursor;
+	mutable Glib::Threads::Mutex _eval_lock;
+
 	mutable Glib::Threads::RWLock _lock;
 
 	Parameter             _parameter;
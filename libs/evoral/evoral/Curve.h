@@ -29,6 +29,7 @@
 namespace Evoral {
 
 class ControlList;
+class ControlEvent;
 
 class LIBEVORAL_API Curve : public boost::noncopyable
 {
@@ -44,6 +45,7 @@ public:
 
 private:
 	double multipoint_eval (Temporal::timepos_t const & x) const;
+	int32_t render_segment (ControlEvent const* before, ControlEvent const* after, float* vec, int32_t i, int32_t veclen, double& rx, double dx) const;
 
 	void _get_vector (Temporal::timepos_t x0, Temporal::timepos_t x1, float *arg, int32_t veclen) const;
 
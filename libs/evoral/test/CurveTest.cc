@@ -2,6 +2,7 @@
 #include "evoral/ControlList.h"
 #include "evoral/Curve.h"
 #include <stdlib.h>
+#include <algorithm>
 
 CPPUNIT_TEST_SUITE_REGISTRATION (CurveTest);
 
@@ -342,6 +343,59 @@ CurveTest::ctrlListEval ()
 	CPPUNIT_ASSERT_EQUAL(9.0, cl->unlocked_eval(t999));
 }
 
+void
+CurveTest::multiPointVector ()
+{
+	/* rendering a vector segment by segment must yield the same values as
+	 * evaluating each sample on its own
+	 */
+	const ControlList::InterpolationStyle styles[] = {
+		ControlList::Discrete,
+		ControlList::Linear,
+		ControlList::Curved,
+		ControlList::Logarithmic,
+		ControlList::Exponential
+	};
+
+	const int32_t veclen = 997;
+	float vec[veclen];
+
+	for (size_t s = 0; s < sizeof (styles) / sizeof (styles[0]); ++s) {
+		Evoral::ParameterDescriptor pd;
+		pd.lower = styles[s] == ControlList::Exponential ? 0 : 0.001;
+		pd.upper = 2;
+
+		Evoral::ControlList l (Evoral::Parameter (0), pd, Temporal::TimeDomainProvider (AudioTime));
+		CPPUNIT_ASSERT (l.set_interpolation (styles[s]));
+		l.create_curve ();
+
+		l.fast_simple_add (timepos_t (0), 0.5);
+		l.fast_simple_add (timepos_t (1000), 0.5);  /* flat */
+		l.fast_simple_add (timepos_t (2000), 1.5);  /* up */
+		l.fast_simple_add (timepos_t (2100), 0.25); /* down */
+		l.fast_simple_add (timepos_t (2101), 0.5);  /* step */
+		l.fast_simple_add (timepos_t (5000), 0.5);
+
+		const timepos_t x0 (10);
+		const timepos_t x1 (4990);
+
+		l.curve ().get_vector (x0, x1, vec, veclen);
+
+		const double dx = (x1.val () - x0.val ()) / (double) (veclen - 1);
+		double       rx = x0.val ();
+
+		for (int32_t i = 0; i < veclen; ++i, rx += dx) {
+			const timepos_t x (timepos_t::from_superclock (rx));
+			float ref;
+			l.curve ().get_vector (x, x, &ref, 1);
+
+			char msg[64];
+			snprintf (msg, 64, "style %d at i=%d", (int) styles[s], i);
+			CPPUNIT_ASSERT_EQUAL_MESSAGE (msg, ref, vec[i]);
+		}
+	}
+}
+
 void
 CurveTest::constrainedCubic ()
 {
@@ -523,3 +577,102 @@ CurveTest::constrainedCubic ()
 		CPPUNIT_ASSERT_DOUBLES_EQUAL(v, g[x], 0.000008);
 	}
 }
+
+/* Linear interpolation as done by searching the event list itself, which is
+ * how ControlList::multipoint_eval() used to look up points. Used as
+ * reference for the contiguous eval index.
+ */
+static double
+list_eval (ControlList::EventList const& events, timepos_t const& x)
+{
+	const ControlEvent cp (x, 0);
+	ControlList::EventList::const_iterator i = std::lower_bound (events.begin (), events.end (), &cp, ControlList::time_comparator);
+
+	if (i == events.end ()) {
+		return events.back ()->value;
+	}
+	if (i == events.begin () || (*i)->when == x) {
+		return (*i)->value;
+	}
+
+	ControlEvent const* after  = *i;
+	ControlEvent const* before = *(--i);
+
+	const double fraction = (double) before->when.distance (x).distance ().val () / (double) before->when.distance (after->when).distance ().val ();
+	return before->value + fraction * (after->value - before->value);
+}
+
+void
+CurveTest::denseEval ()
+{
+	/* a dense lane, as written by a control surface */
+	const int32_t  n_points = 100000;
+	const samplepos_t step  = 480;
+	const int32_t  n_evals  = 1000;
+
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+	cl->set_interpolation (ControlList::Linear);
+
+	for (int32_t i = 0; i < n_points; ++i) {
+		cl->fast_simple_add (timepos_t (i * step), (i % 97) / 97.0);
+	}
+
+	const samplepos_t length = (n_points - 1) * step;
+
+	/* sequential access, as during playback */
+	std::vector<timepos_t> seq;
+	for (int32_t i = 0; i < n_evals; ++i) {
+		seq.push_back (timepos_t ((samplepos_t) i * 1024 % length));
+	}
+
+	/* random access, as when locating or scrolling */
+	std::vector<timepos_t> rnd;
+	srand (0x5eed);
+	for (int32_t i = 0; i < n_evals; ++i) {
+		rnd.push_back (timepos_t ((samplepos_t) (((double) rand () / RAND_MAX) * length)));
+	}
+
+	/* exact points and the ends of the lane */
+	std::vector<timepos_t> edge;
+	edge.push_back (timepos_t (0));
+	edge.push_back (timepos_t (step));
+	edge.push_back (timepos_t (length - 1));
+	edge.push_back (timepos_t (length));
+	edge.push_back (timepos_t (length + step));
+
+	std::vector<timepos_t> const* sets[] = { &seq, &rnd, &edge };
+
+	for (int s = 0; s < 3; ++s) {
+		std::vector<timepos_t> const& xs (*sets[s]);
+		for (std::vector<timepos_t>::const_iterator x = xs.begin (); x != xs.end (); ++x) {
+			CPPUNIT_ASSERT_DOUBLES_EQUAL (list_eval (cl->events (), *x), cl->unlocked_eval (*x), 1e-9);
+		}
+	}
+}
+
+void
+CurveTest::domainBounceEval ()
+{
+	std::shared_ptr<Evoral::ControlList> cl = TestCtrlList();
+
+	cl->fast_simple_add (timepos_t (0), 0.0);
+	cl->fast_simple_add (timepos_t (100), 10.0);
+	cl->fast_simple_add (timepos_t (200), 20.0);
+	cl->set_interpolation (ControlList::Linear);
+
+	/* build the eval index (used with 3 or more events) */
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (5.0, cl->unlocked_eval (timepos_t (50)), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (10.0, cl->unlocked_eval (timepos_t (100)), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (20.0, cl->unlocked_eval (timepos_t (300)), 1e-6);
+
+	/* pretend the bounce moved all events to twice their position */
+	Temporal::DomainBounceInfo dbi (Temporal::AudioTime, Temporal::BeatTime);
+	for (ControlList::const_iterator i = cl->begin (); i != cl->end (); ++i) {
+		dbi.positions.insert (std::make_pair (&(*i)->when, timepos_t ((*i)->when.samples () * 2)));
+	}
+	cl->finish_domain_bounce (dbi);
+
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (2.5, cl->unlocked_eval (timepos_t (50)), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (5.0, cl->unlocked_eval (timepos_t (100)), 1e-6);
+	CPPUNIT_ASSERT_DOUBLES_EQUAL (15.0, cl->unlocked_eval (timepos_t (300)), 1e-6);
+}
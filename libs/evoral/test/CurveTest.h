@@ -15,6 +15,9 @@ class CurveTest : public CppUnit::TestFixture
 	CPPUNIT_TEST (threePointDiscete);
 	CPPUNIT_TEST (constrainedCubic);
 	CPPUNIT_TEST (ctrlListEval);
+	CPPUNIT_TEST (multiPointVector);
+	CPPUNIT_TEST (denseEval);
+	CPPUNIT_TEST (domainBounceEval);
 	CPPUNIT_TEST_SUITE_END ();
 
 public:
@@ -25,6 +28,9 @@ public:
 	void threePointDiscete ();
 	void constrainedCubic ();
 	void ctrlListEval ();
+	void multiPointVector ();
+	void denseEval ();
+	void domainBounceEval ();
 
 private:
 	std::shared_ptr<Evoral::ControlList> TestCtrlList() {
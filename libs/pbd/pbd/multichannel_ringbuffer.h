@@ -0,0 +1,260 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#ifndef multichannel_ringbuffer_h
+#define multichannel_ringbuffer_h
+
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstring>
+
+#include "pbd/libpbd_visibility.h"
+
+namespace PBD {
+
+/** Lock-free single-producer, single-consumer ringbuffer for
+ * a fixed number of channels that advance in lock-step.
+ *
+ * All channels share a single read and write index, so moving
+ * data of N channels costs one atomic load and store per side,
+ * rather than N. The indices are kept on separate cache-lines
+ * to avoid false sharing between the reader and writer thread.
+ */
+template<class T>
+class /*LIBPBD_API*/ MultiChannelRingBuffer
+{
+public:
+	MultiChannelRingBuffer (uint32_t n_channels, size_t sz)
+		: _n_channels (n_channels)
+	{
+		assert (n_channels > 0);
+		size_t power_of_two;
+		for (power_of_two = 1; 1U << power_of_two < sz; ++power_of_two) {}
+		size      = 1U << power_of_two;
+		size_mask = size - 1;
+		buf       = new T[size * _n_channels];
+		reset ();
+	}
+
+	virtual ~MultiChannelRingBuffer () {
+		delete [] buf;
+	}
+
+	void reset () {
+		/* !!! NOT THREAD SAFE !!! */
+		write_idx.store (0);
+		read_idx.store (0);
+	}
+
+	uint32_t n_channels () const { return _n_channels; }
+	size_t   bufsize () const { return size; }
+
+	/* init (mlock) */
+	T* buffer (uint32_t chn) {
+		assert (chn < _n_channels);
+		return &buf[chn * size];
+	}
+
+	size_t write_space () const {
+		return space (write_idx.load (), read_idx.load ());
+	}
+
+	size_t read_space () const {
+		return (write_idx.load () - read_idx.load () + size) & size_mask;
+	}
+
+	/** Write @a cnt samples of every channel, reading from src[chn] + offset */
+	size_t write (T const* const* src, size_t cnt, size_t offset = 0);
+	/** Write @a cnt zero samples to every channel */
+	size_t write_zero (size_t cnt);
+	/** Read @a cnt samples of every channel to dst[chn] + offset */
+	size_t read (T* const* dst, size_t cnt, size_t offset = 0);
+
+	struct rw_vector {
+		T*     buf[2];
+		size_t len[2];
+	};
+
+	/** Get the readable area of channel @a chn. Data becomes
+	 * available for all channels at once, so the length of a
+	 * channel queried later is never smaller.
+	 */
+	void get_read_vector (uint32_t chn, rw_vector*) const;
+	/** Get the writable area of channel @a chn */
+	void get_write_vector (uint32_t chn, rw_vector*) const;
+
+	/** Commit data read from all channels */
+	void increment_read_idx (size_t cnt) {
+		read_idx.store ((read_idx.load () + cnt) & size_mask);
+	}
+
+	/** Commit data written to all channels */
+	void increment_write_idx (size_t cnt) {
+		write_idx.store ((write_idx.load () + cnt) & size_mask);
+	}
+
+	size_t get_write_idx () const { return write_idx.load (); }
+	size_t get_read_idx () const { return read_idx.load (); }
+
+private:
+	size_t space (size_t w, size_t r) const {
+		/* one slot is left empty to tell a full from an empty buffer */
+		return (r - w - 1 + size) & size_mask;
+	}
+
+	void split (size_t idx, size_t cnt, size_t& n1, size_t& n2) const {
+		if (idx + cnt > size) {
+			n1 = size - idx;
+			n2 = (idx + cnt) & size_mask;
+		} else {
+			n1 = cnt;
+			n2 = 0;
+		}
+	}
+
+	/* shared, constant after construction */
+	T*             buf;
+	size_t         size;
+	size_t         size_mask;
+	uint32_t const _n_channels;
+
+	/* each index on its own cache-line */
+	char                        _pad0[64];
+	mutable std::atomic<size_t> write_idx;
+	char                        _pad1[64 - sizeof (std::atomic<size_t>)];
+	mutable std::atomic<size_t> read_idx;
+	char                        _pad2[64 - sizeof (std::atomic<size_t>)];
+
+	MultiChannelRingBuffer (MultiChannelRingBuffer const&);
+};
+
+template<class T> /*LIBPBD_API*/ size_t
+MultiChannelRingBuffer<T>::write (T const* const* src, size_t cnt, size_t offset)
+{
+	size_t const w        = write_idx.load ();
+	size_t const free_cnt = space (w, read_idx.load ());
+
+	if (free_cnt == 0) {
+		return 0;
+	}
+
+	size_t const to_write = cnt > free_cnt ? free_cnt : cnt;
+	size_t       n1, n2;
+
+	split (w, to_write, n1, n2);
+
+	for (uint32_t c = 0; c < _n_channels; ++c) {
+		T* b = &buf[c * size];
+		memcpy (&b[w], src[c] + offset, n1 * sizeof (T));
+		if (n2) {
+			memcpy (b, src[c] + offset + n1, n2 * sizeof (T));
+		}
+	}
+
+	write_idx.store ((w + to_write) & size_mask);
+	return to_write;
+}
+
+template<class T> /*LIBPBD_API*/ size_t
+MultiChannelRingBuffer<T>::write_zero (size_t cnt)
+{
+	size_t const w        = write_idx.load ();
+	size_t const free_cnt = space (w, read_idx.load ());
+
+	if (free_cnt == 0) {
+		return 0;
+	}
+
+	size_t const to_write = cnt > free_cnt ? free_cnt : cnt;
+	size_t       n1, n2;
+
+	split (w, to_write, n1, n2);
+
+	for (uint32_t c = 0; c < _n_channels; ++c) {
+		T* b = &buf[c * size];
+		memset (&b[w], 0, n1 * sizeof (T));
+		if (n2) {
+			memset (b, 0, n2 * sizeof (T));
+		}
+	}
+
+	write_idx.store ((w + to_write) & size_mask);
+	return to_write;
+}
+
+template<class T> /*LIBPBD_API*/ size_t
+MultiChannelRingBuffer<T>::read (T* const* dst, size_t cnt, size_t offset)
+{
+	size_t const r        = read_idx.load ();
+	size_t const free_cnt = (write_idx.load () - r + size) & size_mask;
+
+	if (free_cnt == 0) {
+		return 0;
+	}
+
+	size_t const to_read = cnt > free_cnt ? free_cnt : cnt;
+	size_t       n1, n2;
+
+	split (r, to_read, n1, n2);
+
+	for (uint32_t c = 0; c < _n_channels; ++c) {
+		T const* b = &buf[c * size];
+		memcpy (dst[c] + offset, &b[r], n1 * sizeof (T));
+		if (n2) {
+			memcpy (dst[c] + offset + n1, b, n2 * sizeof (T));
+		}
+	}
+
+	read_idx.store ((r + to_read) & size_mask);
+	return to_read;
+}
+
+template<class T> /*LIBPBD_API*/ void
+MultiChannelRingBuffer<T>::get_read_vector (uint32_t chn, rw_vector* vec) const
+{
+	assert (chn < _n_channels);
+
+	size_t const r        = read_idx.load ();
+	size_t const free_cnt = (write_idx.load () - r + size) & size_mask;
+	T*           b        = &buf[chn * size];
+
+	split (r, free_cnt, vec->len[0], vec->len[1]);
+
+	vec->buf[0] = &b[r];
+	vec->buf[1] = vec->len[1] ? b : 0;
+}
+
+template<class T> /*LIBPBD_API*/ void
+MultiChannelRingBuffer<T>::get_write_vector (uint32_t chn, rw_vector* vec) const
+{
+	assert (chn < _n_channels);
+
+	size_t const w        = write_idx.load ();
+	size_t const free_cnt = space (w, read_idx.load ());
+	T*           b        = &buf[chn * size];
+
+	split (w, free_cnt, vec->len[0], vec->len[1]);
+
+	vec->buf[0] = &b[w];
+	vec->buf[1] = vec->len[1] ? b : 0;
+}
+
+} /* end namespace */
+
+#endif /* multichannel_ringbuffer_h */
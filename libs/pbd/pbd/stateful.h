@@ -107,6 +107,17 @@ class LIBPBD_API Stateful {
 
 	bool property_changes_suspended() const { return _stateful_frozen.load() > 0; }
 
+	/** @return a counter that is incremented whenever a property change
+	 * is signalled, or the ID or extra XML is replaced. This allows
+	 * to re-use previously generated state of unmodified objects.
+	 */
+	uint64_t state_generation () const { return _state_generation.load (); }
+
+	/** Invalidate cached state, for modifications that are not
+	 * signalled via send_change().
+	 */
+	void mark_state_changed () { _state_generation.fetch_add (1); }
+
   protected:
 
 	void add_instant_xml (XMLNode&, const std::string& directory_path);
@@ -143,6 +154,7 @@ class LIBPBD_API Stateful {
 
 	PBD::ID           _id;
 	std::atomic<int> _stateful_frozen;
+	std::atomic<uint64_t> _state_generation;
 
 	static void set_regenerate_xml_and_string_ids_in_this_thread (bool yn);
 };
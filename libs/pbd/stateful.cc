@@ -50,6 +50,7 @@ Stateful::Stateful ()
 	, _properties (new OwnedPropertyList)
 {
 	_stateful_frozen.store (0);
+	_state_generation.store (0);
 }
 
 Stateful::~Stateful ()
@@ -71,6 +72,7 @@ Stateful::add_extra_xml (XMLNode& node)
 
 	_extra_xml->remove_nodes_and_delete (node.name());
 	_extra_xml->add_child_nocopy (node);
+	mark_state_changed ();
 }
 
 XMLNode *
@@ -104,6 +106,7 @@ Stateful::save_extra_xml (const XMLNode& node)
 	if (xtra) {
 		delete _extra_xml;
 		_extra_xml = new XMLNode (*xtra);
+		mark_state_changed ();
 	}
 }
 
@@ -285,6 +288,8 @@ Stateful::send_change (const PropertyChange& what_changed)
 		return;
 	}
 
+	mark_state_changed ();
+
 	{
 		Glib::Threads::Mutex::Lock lm (_lock);
 		if (property_changes_suspended ()) {
@@ -392,6 +397,7 @@ Stateful::set_id (const XMLNode& node)
 	}
 
 	if (node.get_property ("id", _id)) {
+		mark_state_changed ();
 		return true;
 	}
 
@@ -402,6 +408,7 @@ void
 Stateful::reset_id ()
 {
 	_id = ID ();
+	mark_state_changed ();
 }
 
 void
@@ -413,6 +420,7 @@ Stateful::set_id (const string& str)
 		reset_id ();
 	} else {
 		_id = str;
+		mark_state_changed ();
 	}
 }
 
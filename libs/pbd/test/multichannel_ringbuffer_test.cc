@@ -0,0 +1,171 @@
+#include <algorithm>
+#include <pthread.h>
+
+#include "multichannel_ringbuffer_test.h"
+#include "pbd/multichannel_ringbuffer.h"
+
+CPPUNIT_TEST_SUITE_REGISTRATION (MultiChannelRingBufferTest);
+
+using namespace PBD;
+
+#define N_CHANNELS 3
+#define N_SAMPLES  200000
+
+static float
+value (size_t pos, uint32_t chn)
+{
+	return (float)((pos % 65536) * N_CHANNELS + chn);
+}
+
+void
+MultiChannelRingBufferTest::testBasic ()
+{
+	MultiChannelRingBuffer<float> rb (N_CHANNELS, 100);
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 128, rb.bufsize ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 127, rb.write_space ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.read_space ());
+
+	float  in[N_CHANNELS][100];
+	float  out[N_CHANNELS][100];
+	float* src[N_CHANNELS];
+	float* dst[N_CHANNELS];
+
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		for (size_t i = 0; i < 100; ++i) {
+			in[c][i] = value (i, c);
+		}
+		src[c] = in[c];
+		dst[c] = out[c];
+	}
+
+	/* advance, so that following writes wrap around */
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100, rb.write (src, 100));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100, rb.read (dst, 100));
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 60, rb.write (src, 60));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 40, rb.write (src, 40, 60));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 27, rb.write_zero (50));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.write_space ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.write (src, 1));
+	CPPUNIT_ASSERT_EQUAL ((size_t) 127, rb.read_space ());
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 100, rb.read (dst, 100));
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		for (size_t i = 0; i < 100; ++i) {
+			CPPUNIT_ASSERT_EQUAL (value (i, c), out[c][i]);
+		}
+	}
+
+	CPPUNIT_ASSERT_EQUAL ((size_t) 27, rb.read (dst, 100, 50));
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		for (size_t i = 50; i < 77; ++i) {
+			CPPUNIT_ASSERT_EQUAL (0.f, out[c][i]);
+		}
+	}
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.read_space ());
+}
+
+void
+MultiChannelRingBufferTest::testVectors ()
+{
+	MultiChannelRingBuffer<float> rb (N_CHANNELS, 64);
+	MultiChannelRingBuffer<float>::rw_vector vec;
+
+	rb.write_zero (50);
+	rb.increment_read_idx (50);
+
+	/* write 20 samples per channel, wrapping around at 64 */
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		rb.get_write_vector (c, &vec);
+		CPPUNIT_ASSERT_EQUAL ((size_t) 14, vec.len[0]);
+		CPPUNIT_ASSERT_EQUAL ((size_t) 49, vec.len[1]);
+		CPPUNIT_ASSERT (vec.buf[1] == rb.buffer (c));
+		for (size_t i = 0; i < 20; ++i) {
+			if (i < vec.len[0]) {
+				vec.buf[0][i] = value (i, c);
+			} else {
+				vec.buf[1][i - vec.len[0]] = value (i, c);
+			}
+		}
+		/* nothing is visible until the write is committed */
+		CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.read_space ());
+	}
+
+	rb.increment_write_idx (20);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 20, rb.read_space ());
+
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		rb.get_read_vector (c, &vec);
+		CPPUNIT_ASSERT_EQUAL ((size_t) 14, vec.len[0]);
+		CPPUNIT_ASSERT_EQUAL ((size_t) 6, vec.len[1]);
+		for (size_t i = 0; i < 20; ++i) {
+			float v = i < vec.len[0] ? vec.buf[0][i] : vec.buf[1][i - vec.len[0]];
+			CPPUNIT_ASSERT_EQUAL (value (i, c), v);
+		}
+	}
+
+	rb.increment_read_idx (20);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.read_space ());
+	CPPUNIT_ASSERT_EQUAL ((size_t) 63, rb.write_space ());
+}
+
+static void*
+writer (void* arg)
+{
+	MultiChannelRingBuffer<float>* rb = static_cast<MultiChannelRingBuffer<float>*> (arg);
+
+	float  data[N_CHANNELS][37];
+	float* src[N_CHANNELS];
+	size_t pos = 0;
+
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		src[c] = data[c];
+	}
+
+	while (pos < N_SAMPLES) {
+		size_t n = std::min<size_t> (37, N_SAMPLES - pos);
+		for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+			for (size_t i = 0; i < n; ++i) {
+				data[c][i] = value (pos + i, c);
+			}
+		}
+		pos += rb->write (src, n);
+	}
+	return NULL;
+}
+
+void
+MultiChannelRingBufferTest::testThreads ()
+{
+	MultiChannelRingBuffer<float> rb (N_CHANNELS, 256);
+
+	pthread_t writer_thread;
+	CPPUNIT_ASSERT (pthread_create (&writer_thread, NULL, writer, &rb) == 0);
+
+	float  data[N_CHANNELS][29];
+	float* dst[N_CHANNELS];
+	size_t pos    = 0;
+	size_t errors = 0;
+
+	for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+		dst[c] = data[c];
+	}
+
+	while (pos < N_SAMPLES) {
+		size_t n = rb.read (dst, 29);
+		for (uint32_t c = 0; c < N_CHANNELS; ++c) {
+			for (size_t i = 0; i < n; ++i) {
+				if (data[c][i] != value (pos + i, c)) {
+					++errors;
+				}
+			}
+		}
+		pos += n;
+	}
+
+	void* return_value;
+	CPPUNIT_ASSERT (pthread_join (writer_thread, &return_value) == 0);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, errors);
+	CPPUNIT_ASSERT_EQUAL ((size_t) 0, rb.read_space ());
+}
@@ -0,0 +1,17 @@
+#include <cppunit/TestFixture.h>
+#include <cppunit/extensions/HelperMacros.h>
+
+class MultiChannelRingBufferTest : public CppUnit::TestFixture
+{
+	CPPUNIT_TEST_SUITE (MultiChannelRingBufferTest);
+	CPPUNIT_TEST (testBasic);
+	CPPUNIT_TEST (testVectors);
+	CPPUNIT_TEST (testThreads);
+	CPPUNIT_TEST_SUITE_END ();
+
+public:
+	MultiChannelRingBufferTest () { }
+	void testBasic ();
+	void testVectors ();
+	void testThreads ();
+};
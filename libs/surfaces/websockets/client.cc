@@ -16,10 +16,14 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
+#include <cmath>
 #include <sstream>
 
 #include "client.h"
 
+/* meter changes smaller than this are not sent to binary feedback clients */
+#define METER_THRESHOLD_DB 0.1f
+
 using namespace ArdourSurface;
 
 bool
@@ -58,6 +62,51 @@ ClientContext::update_state (const NodeState& node_state)
 	_state.insert (node_state);
 }
 
+void
+ClientContext::set_binary_feedback (bool yn)
+{
+	_binary_feedback = yn;
+	_deferred.clear ();
+	_sent.clear ();
+}
+
+void
+ClientContext::defer (FeedbackBatch::Type type, uint32_t strip_id, float value)
+{
+	/* a client that is slow to read only receives the latest value */
+	_deferred[FeedbackKey (type, strip_id)] = value;
+}
+
+void
+ClientContext::take_deferred (FeedbackBatch& batch)
+{
+	FeedbackValues::iterator it = _deferred.begin ();
+
+	while (it != _deferred.end () && batch.size () < FeedbackBatch::max_entries) {
+		/* gain and pan are already filtered by has_state (), which also
+		 * knows about values written by the client itself */
+		if (it->first.first == FeedbackBatch::StripMeter) {
+			FeedbackValues::iterator sent = _sent.find (it->first);
+			float const              val  = it->second;
+
+			if (sent != _sent.end ()) {
+				float const prev = sent->second;
+				/* always send transitions to and from silence (-inf) */
+				if (std::isfinite (prev) == std::isfinite (val)
+				    && (!std::isfinite (val) || fabsf (val - prev) < METER_THRESHOLD_DB)) {
+					_deferred.erase (it++);
+					continue;
+				}
+			}
+
+			_sent[it->first] = val;
+		}
+
+		batch.add (it->first.first, it->first.second, it->second);
+		_deferred.erase (it++);
+	}
+}
+
 std::string
 ClientContext::debug_str ()
 {
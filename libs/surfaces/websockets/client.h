@@ -21,6 +21,7 @@
 
 #include <set>
 #include <list>
+#include <map>
 
 #include "message.h"
 #include "state.h"
@@ -35,7 +36,8 @@ class ClientContext
 {
 public:
 	ClientContext (Client wsi)
-	    : _wsi (wsi){};
+	    : _wsi (wsi)
+	    , _binary_feedback (false){};
 	virtual ~ClientContext (){};
 
 	Client wsi () const
@@ -51,6 +53,26 @@ public:
 		return _output_buf;
 	}
 
+	/* clients that asked for binary feedback receive meter, gain and pan
+	 * values batched, see FeedbackBatch */
+	bool binary_feedback () const
+	{
+		return _binary_feedback;
+	}
+
+	void set_binary_feedback (bool yn);
+
+	void defer (FeedbackBatch::Type, uint32_t strip_id, float value);
+
+	bool has_deferred () const
+	{
+		return !_deferred.empty ();
+	}
+
+	/* move deferred values into the batch, skipping meter values
+	 * that barely differ from what the client last received */
+	void take_deferred (FeedbackBatch&);
+
 	std::string debug_str ();
 
 private:
@@ -60,6 +82,13 @@ private:
 	ClientState                 _state;
 
 	ClientOutputBuffer _output_buf;
+
+	typedef std::pair<FeedbackBatch::Type, uint32_t> FeedbackKey;
+	typedef std::map<FeedbackKey, float>             FeedbackValues;
+
+	bool           _binary_feedback;
+	FeedbackValues _deferred;
+	FeedbackValues _sent; // meter values
 };
 
 } // namespace ArdourSurface
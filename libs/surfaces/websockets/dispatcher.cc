@@ -38,7 +38,8 @@ WebsocketsDispatcher::NodeMethodMap
 		NODE_METHOD_PAIR (strip_pan)
 		NODE_METHOD_PAIR (strip_mute)
 		NODE_METHOD_PAIR (strip_plugin_enable)
-		NODE_METHOD_PAIR (strip_plugin_param_value);
+		NODE_METHOD_PAIR (strip_plugin_param_value)
+		NODE_METHOD_PAIR (binary_feedback);
 
 void
 WebsocketsDispatcher::dispatch (Client client, const NodeStateMessage& msg)
@@ -267,6 +268,16 @@ WebsocketsDispatcher::strip_plugin_param_value_handler (Client client, const Nod
 	}
 }
 
+void
+WebsocketsDispatcher::binary_feedback_handler (Client client, const NodeStateMessage& msg)
+{
+	const NodeState& state = msg.state ();
+
+	if (msg.is_write () && (state.n_val () > 0)) {
+		server ().set_client_binary_feedback (client, state.nth_val (0));
+	}
+}
+
 void
 WebsocketsDispatcher::update (Client client, std::string node, TypedValue val1)
 {
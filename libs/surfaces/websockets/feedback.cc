@@ -219,6 +219,8 @@ ArdourFeedback::poll () const
 		update_all (Node::strip_meter, it->first, db);
 	}
 
+	server ().flush_feedback ();
+
 	return true;
 }
 
@@ -20,6 +20,8 @@
 #include <iostream>
 #endif
 
+#include <cstring>
+
 #include <boost/lexical_cast.hpp>
 #include <boost/property_tree/json_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -106,6 +108,89 @@ NodeStateMessage::NodeStateMessage (void* buf, size_t len)
 	}
 }
 
+static inline unsigned char*
+write_le32 (unsigned char* p, uint32_t v)
+{
+	p[0] = v & 0xff;
+	p[1] = (v >> 8) & 0xff;
+	p[2] = (v >> 16) & 0xff;
+	p[3] = (v >> 24) & 0xff;
+	return p + 4;
+}
+
+bool
+FeedbackBatch::batchable (const NodeState& state, Type& type, uint32_t& strip_id, float& value)
+{
+	if (state.n_addr () != 1 || state.n_val () != 1) {
+		return false;
+	}
+
+	const std::string node = state.node ();
+
+	if (node == Node::strip_meter) {
+		type = StripMeter;
+	} else if (node == Node::strip_gain) {
+		type = StripGain;
+	} else if (node == Node::strip_pan) {
+		type = StripPan;
+	} else {
+		return false;
+	}
+
+	TypedValue val = state.nth_val (0);
+
+	if (val.type () != TypedValue::Double) {
+		return false;
+	}
+
+	strip_id = state.nth_addr (0);
+	value    = static_cast<double> (val);
+
+	return true;
+}
+
+void
+FeedbackBatch::add (Type type, uint32_t strip_id, float value)
+{
+	Entry e;
+	e.type     = type;
+	e.strip_id = strip_id;
+	e.value    = value;
+	_entries.push_back (e);
+}
+
+size_t
+FeedbackBatch::serialized_size () const
+{
+	return 4 + 9 * _entries.size ();
+}
+
+size_t
+FeedbackBatch::serialize (void* buf, size_t len) const
+{
+	if (_entries.size () > max_entries || len < serialized_size ()) {
+		return 0;
+	}
+
+	unsigned char* p = static_cast<unsigned char*> (buf);
+
+	*p++ = 1; // version
+	*p++ = 0;
+	*p++ = _entries.size () & 0xff;
+	*p++ = (_entries.size () >> 8) & 0xff;
+
+	for (std::vector<Entry>::const_iterator it = _entries.begin (); it != _entries.end (); ++it) {
+		uint32_t v;
+		memcpy (&v, &it->value, sizeof (v));
+
+		*p++ = it->type;
+		p    = write_le32 (p, it->strip_id);
+		p    = write_le32 (p, v);
+	}
+
+	return serialized_size ();
+}
+
 size_t
 NodeStateMessage::serialize (void* buf, size_t len) const
 {
@@ -19,6 +19,9 @@
 #ifndef _ardour_surface_websockets_message_h_
 #define _ardour_surface_websockets_message_h_
 
+#include <stdint.h>
+#include <vector>
+
 #include "state.h"
 
 namespace ArdourSurface {
@@ -50,6 +53,51 @@ private:
 	NodeState _state;
 };
 
+/* Frequently changing strip values, sent to clients that requested
+ * binary feedback as a single binary frame per poll interval.
+ *
+ * Frame layout, all integers and floats are little-endian:
+ *
+ *   uint8   version (1)
+ *   uint8   reserved (0)
+ *   uint16  number of entries
+ *   entries, 9 bytes each:
+ *     uint8   value type (see Type)
+ *     uint32  strip id
+ *     float32 value
+ */
+class FeedbackBatch
+{
+public:
+	enum Type {
+		StripMeter = 1,
+		StripGain  = 2,
+		StripPan   = 3
+	};
+
+	static const size_t max_entries = 65535;
+
+	/* return true if the state can be sent in a batch */
+	static bool batchable (const NodeState&, Type&, uint32_t& strip_id, float& value);
+
+	void add (Type, uint32_t strip_id, float value);
+
+	bool   empty () const { return _entries.empty (); }
+	size_t size () const { return _entries.size (); }
+
+	size_t serialized_size () const;
+	size_t serialize (void*, size_t) const;
+
+private:
+	struct Entry {
+		Type     type;
+		uint32_t strip_id;
+		float    value;
+	};
+
+	std::vector<Entry> _entries;
+};
+
 } // namespace ArdourSurface
 
 #endif // _ardour_surface_websockets_message_h_
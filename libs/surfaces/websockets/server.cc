@@ -20,6 +20,8 @@
 #include <iostream>
 #endif
 
+#include <vector>
+
 #include "dispatcher.h"
 #include "server.h"
 
@@ -216,11 +218,42 @@ WebsocketsServer::update_client (Client wsi, const NodeState& state, bool force)
 	if (force || !it->second.has_state (state)) {
 		/* write to client only if state was updated */
 		it->second.update_state (state);
+
+		FeedbackBatch::Type type;
+		uint32_t            strip_id;
+		float               value;
+
+		if (!force && it->second.binary_feedback ()
+		    && FeedbackBatch::batchable (state, type, strip_id, value)) {
+			/* sent with the next batch, see flush_feedback () */
+			it->second.defer (type, strip_id, value);
+			return;
+		}
+
 		it->second.output_buf ().push_back (NodeStateMessage (state));
 		request_write (wsi);
 	}
 }
 
+void
+WebsocketsServer::set_client_binary_feedback (Client wsi, bool yn)
+{
+	ClientContextMap::iterator it = _client_ctx.find (wsi);
+	if (it != _client_ctx.end ()) {
+		it->second.set_binary_feedback (yn);
+	}
+}
+
+void
+WebsocketsServer::flush_feedback ()
+{
+	for (ClientContextMap::iterator it = _client_ctx.begin (); it != _client_ctx.end (); ++it) {
+		if (it->second.has_deferred ()) {
+			request_write (it->second.wsi ());
+		}
+	}
+}
+
 void
 WebsocketsServer::update_all_clients (const NodeState& state, bool force)
 {
@@ -284,7 +317,7 @@ WebsocketsServer::write_client (Client wsi)
 
 	ClientOutputBuffer& pending = it->second.output_buf ();
 	if (pending.empty ()) {
-		return 0;
+		return write_feedback (wsi, it->second);
 	}
 
 	/* one lws_write() call per LWS_CALLBACK_SERVER_WRITEABLE callback */
@@ -306,7 +339,40 @@ WebsocketsServer::write_client (Client wsi)
 		PBD::error << "ArdourWebsockets: cannot serialize message" << endmsg;
 	}
 
-	if (!pending.empty ()) {
+	if (!pending.empty () || it->second.has_deferred ()) {
+		request_write (wsi);
+	}
+
+	return 0;
+}
+
+int
+WebsocketsServer::write_feedback (Client wsi, ClientContext& ctx)
+{
+	/* the batch is assembled when the client is ready to receive it,
+	 * values that changed in the meantime replace the deferred ones */
+	FeedbackBatch batch;
+	ctx.take_deferred (batch);
+
+	if (batch.empty ()) {
+		return 0;
+	}
+
+	std::vector<unsigned char> out_buf (LWS_PRE + batch.serialized_size ());
+	int len = batch.serialize (&out_buf[LWS_PRE], out_buf.size () - LWS_PRE);
+
+	if (len > 0) {
+#ifdef PRINT_TRAFFIC
+		std::cerr << "TX batch of " << batch.size () << " values" << std::endl;
+#endif
+		if (lws_write (wsi, &out_buf[LWS_PRE], len, LWS_WRITE_BINARY) != len) {
+			return 1;
+		}
+	} else {
+		PBD::error << "ArdourWebsockets: cannot serialize feedback batch" << endmsg;
+	}
+
+	if (ctx.has_deferred ()) {
 		request_write (wsi);
 	}
 
@@ -53,6 +53,11 @@ public:
 	void update_client (Client, const NodeState&, bool);
 	void update_all_clients (const NodeState&, bool);
 
+	/* binary feedback clients receive meter, gain and pan updates
+	 * batched, once per call to flush_feedback () */
+	void set_client_binary_feedback (Client, bool);
+	void flush_feedback ();
+
 private:
 #if LWS_LIBRARY_VERSION_MAJOR < 3
 	struct lws_protocol_vhost_options _lws_vhost_opt;
@@ -72,6 +77,7 @@ private:
 	int del_client (Client);
 	int recv_client (Client, void*, size_t);
 	int write_client (Client);
+	int write_feedback (Client, ClientContext&);
 	int send_availsurf_hdr (Client);
 	int send_availsurf_body (Client);
 
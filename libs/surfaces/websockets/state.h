@@ -47,6 +47,7 @@ namespace Node
 	const std::string transport_bbt                  = "transport_bbt";
 	const std::string transport_roll                 = "transport_roll";
 	const std::string transport_record               = "transport_record";
+	const std::string binary_feedback                = "binary_feedback";
 } // namespace Node
 
 typedef std::vector<uint32_t>   AddressVector;
@@ -1380,6 +1380,16 @@ WaveView::set_image_cache_size (uint64_t sz)
 	WaveViewCache::get_instance()->set_image_cache_threshold (sz);
 }
 
+void
+WaveView::get_image_cache_stats (uint64_t& size, uint64_t& hits, uint64_t& misses)
+{
+	WaveViewCache* cache = WaveViewCache::get_instance ();
+
+	size   = cache->image_cache_size ();
+	hits   = cache->hits ();
+	misses = cache->misses ();
+}
+
 std::shared_ptr<WaveViewCacheGroup>
 WaveView::get_cache_group () const
 {
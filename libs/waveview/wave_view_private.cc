@@ -18,6 +18,7 @@
  */
 
 #include <cmath>
+#include <functional>
 #include "ardour/lmath.h"
 
 #include "pbd/assert.h"
@@ -54,6 +55,33 @@ WaveViewProperties::WaveViewProperties (std::shared_ptr<ARDOUR::AudioRegion> reg
 
 }
 
+template <typename T>
+static inline void
+hash_combine (size_t& seed, T const& v)
+{
+	seed ^= std::hash<T> () (v) + 0x9e3779b9 + (seed << 6) + (seed >> 2);
+}
+
+size_t
+WaveViewProperties::hash () const
+{
+	size_t h = 0;
+	hash_combine (h, samples_per_pixel);
+	hash_combine (h, channel);
+	hash_combine (h, height);
+	hash_combine (h, amplitude);
+	hash_combine (h, amplitude_above_axis);
+	hash_combine (h, fill_color);
+	hash_combine (h, outline_color);
+	hash_combine (h, zero_color);
+	hash_combine (h, clip_color);
+	hash_combine (h, show_zero);
+	hash_combine (h, logscaled);
+	hash_combine (h, (int) shape);
+	hash_combine (h, gradient_depth);
+	return h;
+}
+
 /*-------------------------------------------------*/
 
 WaveViewImage::WaveViewImage (std::shared_ptr<const ARDOUR::AudioRegion> const& region_ptr,
@@ -91,73 +119,73 @@ WaveViewCacheGroup::add_image (std::shared_ptr<WaveViewImage> image)
 		return;
 	}
 
-	ImageCache::iterator oldest_image_it = _cached_images.begin();
-	ImageCache::iterator second_oldest_image_it = _cached_images.end();
+	size_t const key = image->props.hash ();
 
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		if ((*it) == image) {
-			// Must never be more than one instance of the image in the cache
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		} else if ((*it)->props.is_equivalent (image->props)) {
-			// Equivalent Image already in cache, updating timestamp
-			(*it)->timestamp = g_get_monotonic_time ();
-			return;
-		}
+	std::pair<ImageIndex::iterator, ImageIndex::iterator> range = _cached_images.equal_range (key);
 
-		if ((*it)->timestamp < (*oldest_image_it)->timestamp) {
-			second_oldest_image_it = oldest_image_it;
-			oldest_image_it = it;
+	for (ImageIndex::iterator it = range.first; it != range.second; ++it) {
+		std::shared_ptr<WaveViewImage> const& cached = it->second->second;
+		if (cached == image || cached->props.is_equivalent (image->props)) {
+			// Must never be more than one instance of the image, or an equivalent one in the cache
+			_parent_cache.touch (it->second);
+			return;
 		}
 	}
 
-	// no duplicate or equivalent image so we are definitely adding it to cache
-	image->timestamp = g_get_monotonic_time ();
+	_cached_images.insert (std::make_pair (key, _parent_cache.insert (this, image)));
 
-	if (_parent_cache.full () || full ()) {
-		if (oldest_image_it != _cached_images.end()) {
-			// Replacing oldest Image in cache
-			_parent_cache.decrease_size ((*oldest_image_it)->size_in_bytes ());
-			*oldest_image_it = image;
-			_parent_cache.increase_size (image->size_in_bytes ());
-
-			if (second_oldest_image_it != _cached_images.end ()) {
-				// Removing second oldest Image in cache
-				_parent_cache.decrease_size ((*second_oldest_image_it)->size_in_bytes ());
-				_cached_images.erase (second_oldest_image_it);
+	if (full ()) {
+		// Replacing the least recently used Image of this group
+		ImageIndex::iterator oldest = _cached_images.begin ();
+		for (ImageIndex::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
+			if (it->second->second->timestamp < oldest->second->second->timestamp) {
+				oldest = it;
 			}
-			return;
-		} else {
-			/**
-			 * Add the image to the cache even if the threshold is exceeded so that
-			 * new WaveViews can still cache images with a full cache, the size of
-			 * the cache will quickly equalize back to the threshold as new images
-			 * are added and the size of the cache is reduced.
-			 */
 		}
+		_parent_cache.erase (oldest->second);
+		_cached_images.erase (oldest);
 	}
 
-	_cached_images.push_back (image);
-	_parent_cache.increase_size (image->size_in_bytes ());
+	_parent_cache.evict ();
 }
 
 std::shared_ptr<WaveViewImage>
 WaveViewCacheGroup::lookup_image (WaveViewProperties const& props)
 {
-	for (ImageCache::iterator i = _cached_images.begin (); i != _cached_images.end (); ++i) {
-		if ((*i)->props.is_equivalent (props)) {
-			return (*i);
+	std::pair<ImageIndex::iterator, ImageIndex::iterator> range = _cached_images.equal_range (props.hash ());
+
+	for (ImageIndex::iterator it = range.first; it != range.second; ++it) {
+		if (it->second->second->props.is_equivalent (props)) {
+			++_parent_cache._hits;
+			_parent_cache.touch (it->second);
+			return it->second->second;
 		}
 	}
+
+	++_parent_cache._misses;
 	return std::shared_ptr<WaveViewImage>();
 }
 
+void
+WaveViewCacheGroup::drop_image (WaveViewImageLRU::iterator lru)
+{
+	std::pair<ImageIndex::iterator, ImageIndex::iterator> range = _cached_images.equal_range (lru->second->props.hash ());
+
+	for (ImageIndex::iterator it = range.first; it != range.second; ++it) {
+		if (it->second == lru) {
+			_cached_images.erase (it);
+			return;
+		}
+	}
+	assert (0);
+}
+
 void
 WaveViewCacheGroup::clear_cache ()
 {
 	// Tell the parent cache about the images we are about to drop references to
-	for (ImageCache::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
-		_parent_cache.decrease_size ((*it)->size_in_bytes ());
+	for (ImageIndex::iterator it = _cached_images.begin (); it != _cached_images.end (); ++it) {
+		_parent_cache.erase (it->second);
 	}
 	_cached_images.clear ();
 }
@@ -165,8 +193,10 @@ WaveViewCacheGroup::clear_cache ()
 /*-------------------------------------------------*/
 
 WaveViewCache::WaveViewCache ()
-	: image_cache_size (0)
+	: _image_cache_size (0)
 	, _image_cache_threshold (100 * 1048576) /* bytes */
+	, _hits (0)
+	, _misses (0)
 {
 
 }
@@ -182,18 +212,42 @@ WaveViewCache::get_instance ()
 	return instance;
 }
 
+WaveViewImageLRU::iterator
+WaveViewCache::insert (WaveViewCacheGroup* group, std::shared_ptr<WaveViewImage> const& image)
+{
+	image->timestamp = g_get_monotonic_time ();
+	_image_cache_size += image->size_in_bytes ();
+	return _lru.insert (_lru.begin (), std::make_pair (group, image));
+}
+
 void
-WaveViewCache::increase_size (uint64_t bytes)
+WaveViewCache::touch (WaveViewImageLRU::iterator it)
 {
-	image_cache_size += bytes;
+	it->second->timestamp = g_get_monotonic_time ();
+	_lru.splice (_lru.begin (), _lru, it);
 }
 
 void
-WaveViewCache::decrease_size (uint64_t bytes)
+WaveViewCache::erase (WaveViewImageLRU::iterator it)
 {
+	uint64_t bytes = it->second->size_in_bytes ();
 	assert (bytes > 0);
-	assert (bytes <= image_cache_size);
-	image_cache_size -= bytes;
+	assert (bytes <= _image_cache_size);
+	_image_cache_size -= bytes;
+	_lru.erase (it);
+}
+
+void
+WaveViewCache::evict ()
+{
+	/* Always keep the most recently used image, so that new WaveViews can
+	 * still cache images when a single image exceeds the threshold.
+	 */
+	while (full () && _lru.size () > 1) {
+		WaveViewImageLRU::iterator oldest = --_lru.end ();
+		oldest->first->drop_image (oldest);
+		erase (oldest);
+	}
 }
 
 std::shared_ptr<WaveViewCacheGroup>
@@ -251,6 +305,7 @@ void
 WaveViewCache::set_image_cache_threshold (uint64_t sz)
 {
 	_image_cache_threshold = sz;
+	evict ();
 }
 
 /*-------------------------------------------------*/
@@ -146,6 +146,10 @@ public:
 
 	static void set_image_cache_size (uint64_t);
 
+	/* current size of the image cache in bytes, and the number of
+	 * image lookups that did or did not find a cached image */
+	static void get_image_cache_stats (uint64_t& size, uint64_t& hits, uint64_t& misses);
+
 private:
 	friend class WaveViewThreadClient;
 	friend class WaveViewThreads;
@@ -20,6 +20,8 @@
 #define _WAVEVIEW_WAVE_VIEW_PRIVATE_H_
 
 #include <deque>
+#include <list>
+#include <unordered_map>
 
 #include "pbd/pthread_utils.h"
 #include "waveview/wave_view.h"
@@ -162,6 +164,10 @@ public: // methods
 	{
 		return (sample_start <= start && end <= sample_end);
 	}
+
+	/* hash of all properties compared by is_equivalent() except the
+	 * sample range, equivalent properties have the same hash */
+	size_t hash () const;
 };
 
 struct WaveViewImage {
@@ -218,6 +224,10 @@ private:
 };
 
 class WaveViewCache;
+class WaveViewCacheGroup;
+
+/* images of all cache groups, most recently used first */
+typedef std::list<std::pair<WaveViewCacheGroup*, std::shared_ptr<WaveViewImage> > > WaveViewImageLRU;
 
 class WaveViewCacheGroup
 {
@@ -240,6 +250,10 @@ public:
 	void clear_cache ();
 
 private:
+	friend class WaveViewCache;
+
+	// called by the parent cache when evicting an image
+	void drop_image (WaveViewImageLRU::iterator);
 
 	/**
 	 * At time of writing we don't strictly need a reference to the parent cache
@@ -248,8 +262,8 @@ private:
 	 */
 	WaveViewCache& _parent_cache;
 
-	typedef std::list<std::shared_ptr<WaveViewImage> > ImageCache;
-	ImageCache _cached_images;
+	typedef std::unordered_multimap<size_t, WaveViewImageLRU::iterator> ImageIndex;
+	ImageIndex _cached_images; // by WaveViewProperties::hash()
 };
 
 class WaveViewCache
@@ -266,6 +280,12 @@ public:
 
 	void reset_cache_group (std::shared_ptr<WaveViewCacheGroup>&);
 
+	uint64_t image_cache_size () const { return _image_cache_size; }
+
+	/* number of image lookups that did or did not find an equivalent image */
+	uint64_t hits () const { return _hits; }
+	uint64_t misses () const { return _misses; }
+
 private:
 	WaveViewCache();
 	~WaveViewCache();
@@ -276,16 +296,25 @@ private:
 
 	CacheGroups cache_group_map;
 
-	uint64_t image_cache_size;
+	WaveViewImageLRU _lru;
+
+	uint64_t _image_cache_size;
 	uint64_t _image_cache_threshold;
 
+	uint64_t _hits;
+	uint64_t _misses;
+
 private:
 	friend class WaveViewCacheGroup;
 
-	void increase_size (uint64_t bytes);
-	void decrease_size (uint64_t bytes);
+	WaveViewImageLRU::iterator insert (WaveViewCacheGroup*, std::shared_ptr<WaveViewImage> const&);
+	void touch (WaveViewImageLRU::iterator);
+	void erase (WaveViewImageLRU::iterator);
+
+	// drop least recently used images until the cache is below the threshold
+	void evict ();
 
-	bool full () { return image_cache_size > _image_cache_threshold; }
+	bool full () { return _image_cache_size > _image_cache_threshold; }
 };
 
 class WaveViewDrawingThread
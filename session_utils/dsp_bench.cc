@@ -0,0 +1,593 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <glib/gstdio.h>
+#include <glibmm.h>
+
+#include "pbd/file_utils.h"
+#include "pbd/microseconds.h"
+
+#include "ardour/audio_track.h"
+#include "ardour/audioengine.h"
+#include "ardour/audiofilesource.h"
+#include "ardour/audioregion.h"
+#include "ardour/automation_control.h"
+#include "ardour/automation_list.h"
+#include "ardour/butler.h"
+#include "ardour/lua_api.h"
+#include "ardour/playlist.h"
+#include "ardour/plugin_insert.h"
+#include "ardour/rc_configuration.h"
+#include "ardour/region_factory.h"
+#include "ardour/route.h"
+#include "ardour/utils.h"
+
+#include "common.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace SessionUtils;
+
+static void usage ()
+{
+	// help2man compatible format (standard GNU help-text)
+	printf (UTILNAME " - benchmark session DSP without audio hardware.\n\n");
+	printf ("Usage: " UTILNAME " [ OPTIONS ] [session-dir]\n\n");
+	printf ("Options:\n\
+  -a, --automation <num>        Gain automation points per track (default 0)\n\
+  -B, --busses <num>            Number of aux busses (default 0)\n\
+  -b, --buffersize <samples>    Engine buffer size (default 256)\n\
+  -c, --cycles <num>            Number of measured process cycles (default 2000)\n\
+  -h, --help                    Display this help and exit\n\
+  -j, --dsp-threads <num>       Processor usage, see Preferences > Performance\n\
+  -k, --keep                    Keep the generated session\n\
+  -o, --output <file>           Write the JSON report to file (default stdout)\n\
+  -P, --plugin <uri>            LV2 plugin to add (default urn:ardour:a-eq)\n\
+  -p, --plugins <num>           Plugins per track (default 0)\n\
+  -S, --sends <num>             Aux sends per track, at most one per bus (default 0)\n\
+  -s, --samplerate <rate>       Samplerate to use (default 48000)\n\
+  -t, --tracks <num>            Number of mono audio tracks (default 16)\n\
+  -V, --version                 Print version information and exit\n\
+  -W, --butler-threads <num>    Disk I/O threads, 0: automatic (default: rc-config)\n\
+  -w, --work-stealing           Use the work-stealing graph scheduler\n\
+\n");
+
+	printf ("\n\
+This tool creates a synthetic session with the given number of tracks,\n\
+plugins, aux-sends and automation, using the Dummy backend. Every track\n\
+plays back a generated audio file, so that disk-reader and butler\n\
+are exercised as well.\n\
+\n\
+The engine is put into freewheel mode and the given number of process\n\
+cycles are timed once the transport is rolling. The report is a JSON\n\
+object with the per-cycle time distribution (in microseconds), the\n\
+DSP load relative to the nominal cycle period, the utilization of the\n\
+process-graph threads, and butler refill latency.\n\
+\n\
+If no session-dir is given, a temporary folder is used and removed\n\
+when the tool exits, unless --keep is specified.\n\
+\n");
+
+	printf ("\n\
+Examples:\n\
+" UTILNAME " -t 64 -p 2 -B 4 -S 2 -a 100 -c 10000\n\
+\n");
+
+	printf ("Report bugs to <https://tracker.ardour.org/>\n"
+	        "Website: <https://ardour.org/>\n");
+	::exit (EXIT_SUCCESS);
+}
+
+struct BenchState {
+	BenchState (Session* s, size_t n_cycles)
+		: session (s)
+		, measure (n_cycles)
+		, done (false)
+	{
+		cycle_time.reserve (n_cycles);
+	}
+
+	Session*          session;
+	size_t            measure;
+	vector<int64_t>   cycle_time;
+	std::atomic<bool> done;
+};
+
+static void
+freewheel_process (BenchState* bs, pframes_t nframes)
+{
+	if (!bs->session->transport_rolling () || bs->done.load ()) {
+		/* locate, butler refill or already complete */
+		bs->session->process (nframes);
+		return;
+	}
+
+	const int64_t t0 = PBD::get_microseconds ();
+	bs->session->process (nframes);
+	const int64_t t1 = PBD::get_microseconds ();
+
+	bs->cycle_time.push_back (t1 - t0);
+
+	if (bs->cycle_time.size () >= bs->measure) {
+		bs->done.store (true);
+	}
+}
+
+static int
+add_track_region (Session* s, std::shared_ptr<AudioTrack> track, samplecnt_t len)
+{
+	std::shared_ptr<AudioFileSource> afs = s->create_audio_source_for_session (1, track->name (), 0);
+	if (!afs) {
+		return -1;
+	}
+
+	/* white noise, so that nothing can be optimized away */
+	const samplecnt_t bufsize = 8192;
+	Sample            buf[bufsize];
+	uint32_t          rnd = 1 + g_str_hash (track->name ().c_str ());
+
+	for (samplecnt_t pos = 0; pos < len;) {
+		samplecnt_t n = std::min (bufsize, len - pos);
+		for (samplecnt_t i = 0; i < n; ++i) {
+			rnd    = rnd * 1664525 + 1013904223;
+			buf[i] = .25f * ((float)(rnd >> 8) / (float)(1 << 23) - 1.f);
+		}
+		if (afs->write (buf, n) != n) {
+			return -1;
+		}
+		pos += n;
+	}
+
+	time_t xnow;
+	time (&xnow);
+	struct tm* now = localtime (&xnow);
+
+	afs->update_header (0, *now, xnow);
+	afs->flush_header ();
+	afs->mark_immutable ();
+	afs->done_with_peakfile_writes ();
+
+	SourceList srcs;
+	srcs.push_back (afs);
+
+	PBD::PropertyList plist;
+	plist.add (Properties::start, timepos_t (0));
+	plist.add (Properties::length, timecnt_t (len));
+	plist.add (Properties::name, afs->name ());
+	plist.add (Properties::whole_file, true);
+
+	std::shared_ptr<Region> whole = RegionFactory::create (srcs, plist);
+
+	PBD::PropertyList plist2;
+	plist2.add (Properties::whole_file, false);
+
+	track->playlist ()->add_region (RegionFactory::create (whole, plist2), timepos_t (0));
+	return 0;
+}
+
+static void
+add_gain_automation (std::shared_ptr<Route> r, uint32_t n_points, samplecnt_t len)
+{
+	std::shared_ptr<AutomationControl> ac = r->gain_control ();
+	std::shared_ptr<AutomationList>    al = ac->alist ();
+
+	al->freeze ();
+	for (uint32_t i = 0; i < n_points; ++i) {
+		al->fast_simple_add (timepos_t ((samplepos_t)(len * (double)i / n_points)), (i & 1) ? 1.0 : 0.5);
+	}
+	al->thaw ();
+
+	ac->set_automation_state (Play);
+}
+
+static double
+percentile (vector<int64_t> const& sorted, double p)
+{
+	if (sorted.empty ()) {
+		return 0;
+	}
+	size_t i = ceil (p * sorted.size ());
+	return sorted[std::min (std::max<size_t> (i, 1), sorted.size ()) - 1];
+}
+
+static string
+json_escape (string const& s)
+{
+	string rv;
+	for (string::const_iterator i = s.begin (); i != s.end (); ++i) {
+		if (*i == '"' || *i == '\\') {
+			rv += '\\';
+		}
+		rv += *i;
+	}
+	return rv;
+}
+
+int
+main (int argc, char* argv[])
+{
+	int      sample_rate    = 48000;
+	uint32_t buffer_size    = 256;
+	uint32_t n_tracks       = 16;
+	uint32_t n_plugins      = 0;
+	uint32_t n_busses       = 0;
+	uint32_t n_sends        = 0;
+	uint32_t n_automation   = 0;
+	uint32_t n_cycles       = 2000;
+	int      dsp_threads    = INT32_MIN;
+	int      butler_threads = -1;
+	bool     work_stealing  = false;
+	bool     keep_session   = false;
+	string   plugin_uri     = "urn:ardour:a-eq";
+	string   outfile;
+
+	const char* optstring = "a:B:b:c:hj:ko:P:p:S:s:t:VW:w";
+
+	/* clang-format off */
+	const struct option longopts[] = {
+		{ "automation",     required_argument, 0, 'a' },
+		{ "busses",         required_argument, 0, 'B' },
+		{ "buffersize",     required_argument, 0, 'b' },
+		{ "cycles",         required_argument, 0, 'c' },
+		{ "help",           no_argument,       0, 'h' },
+		{ "dsp-threads",    required_argument, 0, 'j' },
+		{ "keep",           no_argument,       0, 'k' },
+		{ "output",         required_argument, 0, 'o' },
+		{ "plugin",         required_argument, 0, 'P' },
+		{ "plugins",        required_argument, 0, 'p' },
+		{ "sends",          required_argument, 0, 'S' },
+		{ "samplerate",     required_argument, 0, 's' },
+		{ "tracks",         required_argument, 0, 't' },
+		{ "version",        no_argument,       0, 'V' },
+		{ "butler-threads", required_argument, 0, 'W' },
+		{ "work-stealing",  no_argument,       0, 'w' },
+	};
+	/* clang-format on */
+
+	int c = 0;
+	while (EOF != (c = getopt_long (argc, argv,
+	                                optstring, longopts, (int*)0))) {
+		switch (c) {
+			case 'a':
+				n_automation = atoi (optarg);
+				break;
+			case 'B':
+				n_busses = atoi (optarg);
+				break;
+			case 'b': {
+				const int bs = atoi (optarg);
+				if (bs >= 16 && bs <= 8192) {
+					buffer_size = bs;
+				} else {
+					cerr << "Invalid buffer size\n";
+					::exit (EXIT_FAILURE);
+				}
+			} break;
+			case 'c':
+				n_cycles = atoi (optarg);
+				if (n_cycles < 1) {
+					cerr << "Invalid cycle count\n";
+					::exit (EXIT_FAILURE);
+				}
+				break;
+			case 'j':
+				dsp_threads = atoi (optarg);
+				break;
+			case 'k':
+				keep_session = true;
+				break;
+			case 'o':
+				outfile = optarg;
+				break;
+			case 'P':
+				plugin_uri = optarg;
+				break;
+			case 'p':
+				n_plugins = atoi (optarg);
+				break;
+			case 'S':
+				n_sends = atoi (optarg);
+				break;
+			case 's': {
+				const int sr = atoi (optarg);
+				if (sr >= 8000 && sr <= 192000) {
+					sample_rate = sr;
+				} else {
+					cerr << "Invalid Samplerate\n";
+					::exit (EXIT_FAILURE);
+				}
+			} break;
+			case 't':
+				n_tracks = atoi (optarg);
+				break;
+			case 'W':
+				butler_threads = atoi (optarg);
+				break;
+			case 'w':
+				work_stealing = true;
+				break;
+
+			case 'V':
+				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
+				printf ("Copyright (C) GPL 2026 The Ardour Developers\n");
+				exit (EXIT_SUCCESS);
+				break;
+
+			case 'h':
+				usage ();
+				break;
+
+			default:
+				cerr << "Error: unrecognized option. See --help for usage information.\n";
+				::exit (EXIT_FAILURE);
+				break;
+		}
+	}
+
+	if (n_sends > n_busses) {
+		cerr << "Error: cannot have more sends per track than busses.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	string session_dir;
+	bool   tmp_session = false;
+
+	if (optind + 1 == argc) {
+		session_dir = argv[optind];
+	} else if (optind == argc) {
+		char* tmp = g_dir_make_tmp ("dspbenchXXXXXX", NULL);
+		if (!tmp) {
+			cerr << "Error: cannot create temporary folder.\n";
+			::exit (EXIT_FAILURE);
+		}
+		session_dir = Glib::build_filename (tmp, "DSPBench");
+		tmp_session = true;
+		g_free (tmp);
+	} else {
+		cerr << "Error: Too many parameters. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	/* all systems go */
+
+	SessionUtils::init (false);
+
+	if (dsp_threads != INT32_MIN) {
+		Config->set_processor_usage (dsp_threads);
+	}
+	if (butler_threads >= 0) {
+		Config->set_butler_threads (butler_threads);
+	}
+	Config->set_graph_work_stealing (work_stealing);
+
+	Session* s = 0;
+
+	try {
+		s = SessionUtils::create_session (session_dir, "DSPBench", sample_rate);
+	} catch (ARDOUR::SessionException& e) {
+		cerr << "Error: " << e.what () << "\n";
+	} catch (...) {
+		cerr << "Error: unknown exception.\n";
+	}
+
+	if (!s) {
+		SessionUtils::cleanup ();
+		::exit (EXIT_FAILURE);
+	}
+
+	AudioEngine* engine = AudioEngine::instance ();
+
+	if (engine->set_buffer_size (buffer_size)) {
+		cerr << "Cannot set buffer size.\n";
+	}
+
+	/* play the sources for the duration of the benchmark, plus some margin
+	 * for locate and initial butler refill.
+	 */
+	const samplecnt_t len = (samplecnt_t)(n_cycles + 1) * engine->samples_per_cycle () + 5 * engine->sample_rate ();
+
+	/* create synthetic session */
+
+	list<std::shared_ptr<AudioTrack>> tracks = s->new_audio_track (1, 2, 0, n_tracks, "Track", PresentationInfo::max_order);
+	RouteList                         busses;
+
+	if (tracks.size () != n_tracks) {
+		cerr << "Error: cannot create tracks\n";
+		SessionUtils::unload_session (s);
+		SessionUtils::cleanup ();
+		::exit (EXIT_FAILURE);
+	}
+
+	if (n_busses > 0) {
+		busses = s->new_audio_route (2, 2, 0, n_busses, "Bus", PresentationInfo::AudioBus, PresentationInfo::max_order);
+	}
+
+	std::shared_ptr<RouteList> senders (new RouteList);
+
+	for (auto const& t : tracks) {
+		if (add_track_region (s, t, len)) {
+			cerr << "Error: cannot create source for " << t->name () << "\n";
+			SessionUtils::unload_session (s);
+			SessionUtils::cleanup ();
+			::exit (EXIT_FAILURE);
+		}
+
+		for (uint32_t i = 0; i < n_plugins; ++i) {
+			std::shared_ptr<Processor> p = LuaAPI::new_plugin (s, plugin_uri, ARDOUR::LV2);
+			if (!p || t->add_processor (p, PreFader)) {
+				cerr << "Error: cannot add plugin '" << plugin_uri << "' to " << t->name () << "\n";
+				SessionUtils::unload_session (s);
+				SessionUtils::cleanup ();
+				::exit (EXIT_FAILURE);
+			}
+		}
+
+		if (n_automation > 0) {
+			add_gain_automation (t, n_automation, len);
+		}
+
+		senders->push_back (t);
+	}
+
+	uint32_t n = 0;
+	for (auto const& b : busses) {
+		if (n++ >= n_sends) {
+			break;
+		}
+		s->add_internal_sends (b, PreFader, senders);
+	}
+
+	s->save_state ("");
+
+	/* run */
+
+	BenchState           bs (s, n_cycles);
+	PBD::ScopedConnection c_fw;
+
+	engine->Freewheel.connect_same_thread (c_fw, boost::bind (&freewheel_process, &bs, _1));
+
+	s->butler ()->reset_refill_latency ();
+	s->request_locate (0, false, MustRoll);
+
+	if (engine->freewheel (true)) {
+		cerr << "Error: cannot start freewheeling\n";
+		c_fw.disconnect ();
+		SessionUtils::unload_session (s);
+		SessionUtils::cleanup ();
+		::exit (EXIT_FAILURE);
+	}
+
+	while (!bs.done.load ()) {
+		Glib::usleep (10000);
+	}
+
+	engine->freewheel (false);
+	c_fw.disconnect ();
+	s->request_stop ();
+
+	/* collect results */
+
+	vector<int64_t> sorted (bs.cycle_time);
+	std::sort (sorted.begin (), sorted.end ());
+
+	double sum = 0;
+	for (auto const& t : sorted) {
+		sum += t;
+	}
+
+	const double mean   = sorted.empty () ? 0 : sum / sorted.size ();
+	const double period = 1e6 * engine->samples_per_cycle () / engine->sample_rate ();
+
+	/* The graph nodes keep a moving average of their process time,
+	 * the sum over all nodes is the busy time of all graph threads
+	 * per cycle.
+	 */
+	const uint32_t n_threads = how_many_dsp_threads ();
+	double         busy      = 0;
+
+	std::shared_ptr<RouteList const> rl = s->get_routes ();
+	for (auto const& r : *rl) {
+		busy += r->process_time ();
+	}
+
+	int64_t  lat_min = 0;
+	int64_t  lat_max = 0;
+	double   lat_avg = 0;
+	uint64_t lat_cnt = 0;
+
+	s->butler ()->refill_latency (lat_min, lat_max, lat_avg, lat_cnt);
+
+	stringstream ss;
+	ss.precision (3);
+	ss << fixed;
+	ss << "{\n"
+	   << "  \"version\": \"" << VERSIONSTRING << "\",\n"
+	   << "  \"config\": {\n"
+	   << "    \"tracks\": " << n_tracks << ",\n"
+	   << "    \"plugins_per_track\": " << n_plugins << ",\n"
+	   << "    \"plugin\": \"" << json_escape (plugin_uri) << "\",\n"
+	   << "    \"busses\": " << n_busses << ",\n"
+	   << "    \"sends_per_track\": " << n_sends << ",\n"
+	   << "    \"automation_points\": " << n_automation << ",\n"
+	   << "    \"sample_rate\": " << engine->sample_rate () << ",\n"
+	   << "    \"buffer_size\": " << engine->samples_per_cycle () << ",\n"
+	   << "    \"dsp_threads\": " << n_threads << ",\n"
+	   << "    \"butler_threads\": " << Config->get_butler_threads () << ",\n"
+	   << "    \"work_stealing\": " << (Config->get_graph_work_stealing () ? "true" : "false") << "\n"
+	   << "  },\n"
+	   << "  \"cycles\": " << sorted.size () << ",\n"
+	   << "  \"cycle_usec\": {\n"
+	   << "    \"period\": " << period << ",\n"
+	   << "    \"min\": " << (sorted.empty () ? 0 : sorted.front ()) << ",\n"
+	   << "    \"mean\": " << mean << ",\n"
+	   << "    \"p50\": " << percentile (sorted, .5) << ",\n"
+	   << "    \"p90\": " << percentile (sorted, .9) << ",\n"
+	   << "    \"p99\": " << percentile (sorted, .99) << ",\n"
+	   << "    \"p999\": " << percentile (sorted, .999) << ",\n"
+	   << "    \"max\": " << (sorted.empty () ? 0 : sorted.back ()) << "\n"
+	   << "  },\n"
+	   << "  \"dsp_load\": {\n"
+	   << "    \"mean\": " << mean / period << ",\n"
+	   << "    \"p99\": " << percentile (sorted, .99) / period << "\n"
+	   << "  },\n"
+	   << "  \"graph\": {\n"
+	   << "    \"threads\": " << n_threads << ",\n"
+	   << "    \"busy_usec\": " << busy << ",\n"
+	   << "    \"utilization\": " << (mean > 0 ? busy / (mean * n_threads) : 0) << "\n"
+	   << "  },\n"
+	   << "  \"butler\": {\n"
+	   << "    \"refills\": " << lat_cnt << ",\n"
+	   << "    \"latency_usec_min\": " << lat_min << ",\n"
+	   << "    \"latency_usec_avg\": " << lat_avg << ",\n"
+	   << "    \"latency_usec_max\": " << lat_max << "\n"
+	   << "  }\n"
+	   << "}\n";
+
+	if (outfile.empty ()) {
+		cout << ss.str ();
+	} else {
+		ofstream f (outfile.c_str ());
+		f << ss.str ();
+		if (!f) {
+			cerr << "Error: cannot write to '" << outfile << "'\n";
+		}
+	}
+
+	SessionUtils::unload_session (s);
+	SessionUtils::cleanup ();
+
+	if (tmp_session && !keep_session) {
+		PBD::remove_directory (session_dir);
+		g_rmdir (Glib::path_get_dirname (session_dir).c_str ());
+	} else {
+		cerr << "Session kept in '" << session_dir << "'\n";
+	}
+
+	return 0;
+}
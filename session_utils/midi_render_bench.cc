@@ -0,0 +1,419 @@
+/*
+ * Copyright (C) 2026 The Ardour Developers
+ *
+ * This program is free software; you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation; either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along
+ * with this program; if not, write to the Free Software Foundation, Inc.,
+ * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
+ */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <getopt.h>
+#include <iostream>
+#include <sstream>
+#include <vector>
+
+#include <glib/gstdio.h>
+#include <glibmm.h>
+
+#include "pbd/compose.h"
+#include "pbd/file_utils.h"
+#include "pbd/microseconds.h"
+
+#include "evoral/Event.h"
+#include "evoral/midi_events.h"
+
+#include "ardour/midi_model.h"
+#include "ardour/midi_playlist.h"
+#include "ardour/midi_region.h"
+#include "ardour/playlist_factory.h"
+#include "ardour/region_factory.h"
+#include "ardour/rt_midibuffer.h"
+#include "ardour/smf_source.h"
+
+#include "common.h"
+
+using namespace std;
+using namespace ARDOUR;
+using namespace SessionUtils;
+
+static void usage ()
+{
+	// help2man compatible format (standard GNU help-text)
+	printf (UTILNAME " - compare full and incremental MIDI playlist rendering.\n\n");
+	printf ("Usage: " UTILNAME " [ OPTIONS ]\n\n");
+	printf ("Options:\n\
+  -e, --edits <num>             Number of measured note edits (default 200)\n\
+  -h, --help                    Display this help and exit\n\
+  -n, --notes <num>             Notes per region (default 50000)\n\
+  -o, --output <file>           Write the JSON report to file (default stdout)\n\
+  -r, --regions <num>           Number of adjacent regions (default 4)\n\
+  -V, --version                 Print version information and exit\n\
+\n");
+
+	printf ("\n\
+This tool creates a hidden MIDI playlist with the given number of\n\
+regions, each with a synthetic model of the given number of notes.\n\
+\n\
+Each measured iteration applies a single note edit (alternately\n\
+changing the velocity or moving the start of a random note) and\n\
+times the incremental render of the playlist. The result is then\n\
+compared to a complete render, which is timed as well.\n\
+\n\
+The report is a JSON object with the per-render time distribution\n\
+(in microseconds) of both methods. The tool fails if the incremental\n\
+result differs from the complete render.\n\
+\n");
+
+	printf ("\n\
+Examples:\n\
+" UTILNAME " -n 200000 -r 8 -e 1000\n\
+\n");
+
+	printf ("Report bugs to <https://tracker.ardour.org/>\n"
+	        "Website: <https://ardour.org/>\n");
+	::exit (EXIT_SUCCESS);
+}
+
+typedef pair<samplepos_t, vector<uint8_t>> RenderedEvent;
+
+static void
+snapshot (RTMidiBuffer& rtmb, vector<RenderedEvent>& events)
+{
+	events.clear ();
+	events.reserve (rtmb.size ());
+
+	for (size_t n = 0; n < rtmb.size (); ++n) {
+		uint32_t       size;
+		uint8_t const* buf = rtmb.bytes (rtmb[n], size);
+		events.push_back (make_pair (rtmb[n].timestamp, vector<uint8_t> (buf, buf + size)));
+	}
+
+	/* the order of simultaneous events is not relevant */
+	std::sort (events.begin (), events.end ());
+}
+
+static std::shared_ptr<MidiRegion>
+add_region (Session* s, std::shared_ptr<MidiPlaylist> pl, uint32_t n, uint32_t n_notes, uint32_t& rnd)
+{
+	std::shared_ptr<SMFSource> src = std::dynamic_pointer_cast<SMFSource> (s->create_midi_source_for_session (string_compose ("Bench%1", n)));
+	if (!src) {
+		return std::shared_ptr<MidiRegion> ();
+	}
+
+	/* sixteenth notes with random pitch, velocity and length, up to one bar */
+	vector<Evoral::Event<Temporal::Beats>*> events;
+	events.reserve (2 * n_notes);
+
+	for (uint32_t i = 0; i < n_notes; ++i) {
+		rnd = rnd * 1664525 + 1013904223;
+
+		uint8_t buf[3];
+		buf[0] = MIDI_CMD_NOTE_ON | ((rnd >> 8) & 0x03);
+		buf[1] = 24 + (rnd >> 10) % 72;
+		buf[2] = 1 + (rnd >> 17) % 127;
+
+		Temporal::Beats const on  = Temporal::Beats::ticks ((int64_t) i * Temporal::ticks_per_beat / 4);
+		Temporal::Beats const off = on + Temporal::Beats::ticks (1 + (rnd >> 24) * Temporal::ticks_per_beat / 64);
+
+		events.push_back (new Evoral::Event<Temporal::Beats> (Evoral::MIDI_EVENT, on, 3, buf, true));
+		buf[0] = MIDI_CMD_NOTE_OFF | (buf[0] & 0x0f);
+		buf[2] = 0x40;
+		events.push_back (new Evoral::Event<Temporal::Beats> (Evoral::MIDI_EVENT, off, 3, buf, true));
+	}
+
+	std::stable_sort (events.begin (), events.end (), [] (Evoral::Event<Temporal::Beats> const* a, Evoral::Event<Temporal::Beats> const* b) { return a->time () < b->time (); });
+
+	{
+		Source::WriterLock lck (src->mutex ());
+		src->mark_streaming_midi_write_started (lck, Sustained);
+		src->begin_write ();
+		for (auto const& e : events) {
+			src->append_event_beats (lck, *e);
+		}
+		src->end_write (src->path ());
+		src->mark_streaming_write_completed (lck);
+	}
+
+	for (auto const& e : events) {
+		delete e;
+	}
+
+	Temporal::Beats const len = Temporal::Beats::ticks ((int64_t) n_notes * Temporal::ticks_per_beat / 4);
+
+	SourceList srcs;
+	srcs.push_back (src);
+
+	PBD::PropertyList plist;
+	plist.add (Properties::start, timepos_t (Temporal::Beats ()));
+	plist.add (Properties::length, timecnt_t (len));
+	plist.add (Properties::name, src->name ());
+	plist.add (Properties::whole_file, true);
+
+	std::shared_ptr<Region> whole = RegionFactory::create (srcs, plist);
+
+	PBD::PropertyList plist2;
+	plist2.add (Properties::whole_file, false);
+
+	std::shared_ptr<MidiRegion> mr = std::dynamic_pointer_cast<MidiRegion> (RegionFactory::create (whole, plist2));
+
+	/* leave a bar between regions */
+	pl->add_region (mr, timepos_t (Temporal::Beats ((len.get_beats () + 4) * n, 0)));
+	return mr;
+}
+
+static void
+edit_note (Session* s, std::shared_ptr<MidiRegion> mr, uint32_t iteration, uint32_t& rnd)
+{
+	std::shared_ptr<MidiModel> model = mr->model ();
+
+	MidiModel::Notes const& notes (model->notes ());
+	rnd = rnd * 1664525 + 1013904223;
+
+	MidiModel::Notes::const_iterator i = notes.begin ();
+	std::advance (i, (rnd >> 8) % notes.size ());
+
+	MidiModel::NoteDiffCommand* cmd = model->new_note_diff_command ("bench");
+	if (iteration & 1) {
+		Temporal::Beats const t = (*i)->time () + Temporal::Beats::ticks (Temporal::ticks_per_beat / 8);
+		cmd->change (*i, MidiModel::NoteDiffCommand::StartTime, t);
+	} else {
+		cmd->change (*i, MidiModel::NoteDiffCommand::Velocity, (uint8_t) (1 + (rnd >> 16) % 127));
+	}
+
+	model->apply_diff_command_only (*s, cmd);
+	delete cmd;
+}
+
+static double
+percentile (vector<int64_t> const& sorted, double p)
+{
+	if (sorted.empty ()) {
+		return 0;
+	}
+	size_t i = ceil (p * sorted.size ());
+	return sorted[std::min (std::max<size_t> (i, 1), sorted.size ()) - 1];
+}
+
+static void
+json_stats (stringstream& ss, char const* name, vector<int64_t>& t, bool last)
+{
+	std::sort (t.begin (), t.end ());
+
+	double sum = 0;
+	for (auto const& v : t) {
+		sum += v;
+	}
+
+	ss << "  \"" << name << "\": {\n"
+	   << "    \"min\": " << (t.empty () ? 0 : t.front ()) << ",\n"
+	   << "    \"mean\": " << (t.empty () ? 0 : sum / t.size ()) << ",\n"
+	   << "    \"p50\": " << percentile (t, .5) << ",\n"
+	   << "    \"p90\": " << percentile (t, .9) << ",\n"
+	   << "    \"p99\": " << percentile (t, .99) << ",\n"
+	   << "    \"max\": " << (t.empty () ? 0 : t.back ()) << "\n"
+	   << "  }" << (last ? "\n" : ",\n");
+}
+
+int
+main (int argc, char* argv[])
+{
+	uint32_t n_notes   = 50000;
+	uint32_t n_regions = 4;
+	uint32_t n_edits   = 200;
+	string   outfile;
+
+	const char* optstring = "e:hn:o:r:V";
+
+	/* clang-format off */
+	const struct option longopts[] = {
+		{ "edits",   required_argument, 0, 'e' },
+		{ "help",    no_argument,       0, 'h' },
+		{ "notes",   required_argument, 0, 'n' },
+		{ "output",  required_argument, 0, 'o' },
+		{ "regions", required_argument, 0, 'r' },
+		{ "version", no_argument,       0, 'V' },
+	};
+	/* clang-format on */
+
+	int c = 0;
+	while (EOF != (c = getopt_long (argc, argv,
+	                                optstring, longopts, (int*)0))) {
+		switch (c) {
+			case 'e':
+				n_edits = atoi (optarg);
+				break;
+			case 'n':
+				n_notes = atoi (optarg);
+				break;
+			case 'o':
+				outfile = optarg;
+				break;
+			case 'r':
+				n_regions = atoi (optarg);
+				break;
+
+			case 'V':
+				printf ("ardour-utils version %s\n\n", VERSIONSTRING);
+				printf ("Copyright (C) GPL 2026 The Ardour Developers\n");
+				exit (EXIT_SUCCESS);
+				break;
+
+			case 'h':
+				usage ();
+				break;
+
+			default:
+				cerr << "Error: unrecognized option. See --help for usage information.\n";
+				::exit (EXIT_FAILURE);
+				break;
+		}
+	}
+
+	if (n_notes < 1 || n_regions < 1) {
+		cerr << "Error: need at least one region and one note.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	if (optind != argc) {
+		cerr << "Error: Too many parameters. See --help for usage information.\n";
+		::exit (EXIT_FAILURE);
+	}
+
+	char* tmp = g_dir_make_tmp ("midibenchXXXXXX", NULL);
+	if (!tmp) {
+		cerr << "Error: cannot create temporary folder.\n";
+		::exit (EXIT_FAILURE);
+	}
+	string session_dir = Glib::build_filename (tmp, "MIDIRenderBench");
+	g_free (tmp);
+
+	/* all systems go */
+
+	SessionUtils::init (false);
+
+	Session* s = 0;
+
+	try {
+		s = SessionUtils::create_session (session_dir, "MIDIRenderBench", 48000);
+	} catch (ARDOUR::SessionException& e) {
+		cerr << "Error: " << e.what () << "\n";
+	} catch (...) {
+		cerr << "Error: unknown exception.\n";
+	}
+
+	if (!s) {
+		SessionUtils::cleanup ();
+		::exit (EXIT_FAILURE);
+	}
+
+	/* The playlist is not used by a track, so the butler does not render
+	 * it concurrently.
+	 */
+	std::shared_ptr<MidiPlaylist> pl = std::dynamic_pointer_cast<MidiPlaylist> (PlaylistFactory::create (DataType::MIDI, *s, "MIDIRenderBench", true));
+
+	vector<std::shared_ptr<MidiRegion>> regions;
+	uint32_t                            rnd = 1;
+
+	for (uint32_t n = 0; n < n_regions; ++n) {
+		std::shared_ptr<MidiRegion> mr = add_region (s, pl, n, n_notes, rnd);
+		if (!mr) {
+			cerr << "Error: cannot create MIDI source\n";
+			SessionUtils::unload_session (s);
+			SessionUtils::cleanup ();
+			::exit (EXIT_FAILURE);
+		}
+		regions.push_back (mr);
+	}
+
+	/* run */
+
+	vector<int64_t>       t_full;
+	vector<int64_t>       t_incr;
+	vector<RenderedEvent> incr;
+	vector<RenderedEvent> full;
+	uint32_t              mismatch = 0;
+
+	t_full.reserve (n_edits);
+	t_incr.reserve (n_edits);
+
+	pl->render (0, false);
+
+	for (uint32_t i = 0; i < n_edits; ++i) {
+		edit_note (s, regions[(rnd >> 12) % regions.size ()], i, rnd);
+
+		int64_t t0 = PBD::get_microseconds ();
+		pl->render (0, true);
+		t_incr.push_back (PBD::get_microseconds () - t0);
+
+		snapshot (*pl->rendered (), incr);
+
+		t0 = PBD::get_microseconds ();
+		pl->render (0, false);
+		t_full.push_back (PBD::get_microseconds () - t0);
+
+		snapshot (*pl->rendered (), full);
+
+		if (incr != full) {
+			++mismatch;
+		}
+	}
+
+	size_t const n_events = pl->rendered ()->size ();
+
+	stringstream ss;
+	ss.precision (3);
+	ss << fixed;
+	ss << "{\n"
+	   << "  \"version\": \"" << VERSIONSTRING << "\",\n"
+	   << "  \"config\": {\n"
+	   << "    \"regions\": " << n_regions << ",\n"
+	   << "    \"notes_per_region\": " << n_notes << ",\n"
+	   << "    \"edits\": " << n_edits << "\n"
+	   << "  },\n"
+	   << "  \"events\": " << n_events << ",\n"
+	   << "  \"mismatches\": " << mismatch << ",\n";
+
+	json_stats (ss, "full_usec", t_full, false);
+	json_stats (ss, "incremental_usec", t_incr, true);
+
+	ss << "}\n";
+
+	if (outfile.empty ()) {
+		cout << ss.str ();
+	} else {
+		ofstream f (outfile.c_str ());
+		f << ss.str ();
+		if (!f) {
+			cerr << "Error: cannot write to '" << outfile << "'\n";
+		}
+	}
+
+	pl.reset ();
+	regions.clear ();
+
+	SessionUtils::unload_session (s);
+	SessionUtils::cleanup ();
+
+	PBD::remove_directory (session_dir);
+	g_rmdir (Glib::path_get_dirname (session_dir).c_str ());
+
+	if (mismatch > 0) {
+		cerr << "Error: " << mismatch << " incremental renders differ from the complete render.\n";
+		return 1;
+	}
+
+	return 0;
+}
@@ -16,7 +16,7 @@
  * 51 Franklin Street, Fifth Floor, Boston, MA 02110-1301 USA.
  */
 
-import { Message } from './protocol.js';
+import { Message, StateNode } from './protocol.js';
 
 export default class MessageChannel {
 
@@ -29,12 +29,21 @@ export default class MessageChannel {
 	async open () {
 		return new Promise((resolve, reject) => {
 			this._socket = new WebSocket(`ws://${this._host}`);
+			this._socket.binaryType = 'arraybuffer';
 
 			this._socket.onclose = () => this.onClose();
 
 			this._socket.onerror = (error) => this.onError(error);
 
 			this._socket.onmessage = (event) => {
+				if (event.data instanceof ArrayBuffer) {
+					// batched meter, gain and pan values
+					for (const msg of Message.fromBinaryFeedback(event.data)) {
+						this.onMessage(msg, true);
+					}
+					return;
+				}
+
 				const msg = Message.fromJsonText(event.data);
 
 				if (this._pending && (this._pending.nodeAddrId == msg.nodeAddrId)) {
@@ -45,7 +54,12 @@ export default class MessageChannel {
 				}
 			};
 
-			this._socket.onopen = resolve;
+			this._socket.onopen = () => {
+				// ask for meter, gain and pan updates in binary batches
+				const msg = new Message(StateNode.BINARY_FEEDBACK, [], [true]);
+				this._socket.send(msg.toJsonText());
+				resolve();
+			};
 		});
 	}
 
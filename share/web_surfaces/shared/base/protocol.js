@@ -31,9 +31,19 @@ export const StateNode = Object.freeze({
 	TRANSPORT_TEMPO                : 'transport_tempo',
 	TRANSPORT_TIME                 : 'transport_time',
 	TRANSPORT_ROLL                 : 'transport_roll',
-	TRANSPORT_RECORD               : 'transport_record'
+	TRANSPORT_RECORD               : 'transport_record',
+	BINARY_FEEDBACK                : 'binary_feedback'
 });
 
+// value types of binary feedback frames, see FeedbackBatch in message.h
+const BinaryFeedbackNode = Object.freeze({
+	1 : StateNode.STRIP_METER,
+	2 : StateNode.STRIP_GAIN,
+	3 : StateNode.STRIP_PAN
+});
+
+const BINARY_FEEDBACK_VERSION = 1;
+
 export class Message {
 
 	constructor (node, addr, val) {
@@ -61,6 +71,29 @@ export class Message {
 		return new Message(rawMsg.node, rawMsg.addr || [], rawMsg.val);
 	}
 
+	static fromBinaryFeedback (buffer) {
+		const view = new DataView(buffer);
+		const messages = [];
+
+		if ((view.byteLength < 4) || (view.getUint8(0) != BINARY_FEEDBACK_VERSION)) {
+			return messages;
+		}
+
+		const count = view.getUint16(2, true);
+
+		for (let i = 0, offset = 4; (i < count) && (offset + 9 <= view.byteLength); i++, offset += 9) {
+			const node = BinaryFeedbackNode[view.getUint8(offset)];
+
+			if (node) {
+				const stripId = view.getUint32(offset + 1, true);
+				const value = view.getFloat32(offset + 5, true);
+				messages.push(new Message(node, [stripId], [value]));
+			}
+		}
+
+		return messages;
+	}
+
 	toJsonText () {
 		let val = [];
 